@@ -0,0 +1,85 @@
+#include "harness.hpp"
+
+#include "ucosm/core/callable_task.hpp"
+#include "ucosm/periodic/iperiodic_task.hpp"
+
+#include <functional>
+
+namespace {
+
+    constexpr std::size_t ops = 1000000;
+
+    uint32_t sCounter = 0;
+
+    void increment() {
+        sCounter++;
+    }
+
+}
+
+namespace bench {
+
+    void callableBenchmarks(Harness& inHarness) {
+
+        uint32_t local = 0;
+        auto lambda = [&local] { local++; };
+
+        {
+            ucosm::CallableTask<ucosm::IPeriodicTask> task(lambda);
+            // run() is only reachable through the task interface
+            ucosm::IPeriodicTask& itask = task;
+
+            inHarness.measure("callable_invoke", "callable_task_lambda", 1, ops,
+                [&] { local = 0; },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        itask.run();
+                    }
+                }
+            );
+        }
+
+        {
+            std::function<void()> function(lambda);
+
+            inHarness.measure("callable_invoke", "std_function_lambda", 1, ops,
+                [&] { local = 0; },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        function();
+                    }
+                }
+            );
+        }
+
+        {
+            ucosm::CallableTask<ucosm::IPeriodicTask> task(&increment);
+            ucosm::IPeriodicTask& itask = task;
+
+            inHarness.measure("callable_invoke", "callable_task_function", 1, ops,
+                [] { sCounter = 0; },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        itask.run();
+                    }
+                }
+            );
+        }
+
+        {
+            std::function<void()> function(&increment);
+
+            inHarness.measure("callable_invoke", "std_function_function", 1, ops,
+                [] { sCounter = 0; },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        function();
+                    }
+                }
+            );
+        }
+
+        gSink = gSink + local + sCounter;
+    }
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    /**
+     * @brief Measurement of a benchmark case.
+     */
+    struct Result {
+        std::string name;
+        std::string variant;
+        std::size_t tasks = 0;
+        std::size_t ops = 0;
+        double nsPerOp = 0;
+    };
+
+    /**
+     * @brief Runs benchmark cases and collects their results.
+     */
+    struct Harness {
+
+        using clock_t = std::chrono::steady_clock;
+
+        /**
+         * @brief Largest task count measured.
+         */
+        std::size_t mMaxTasks = 1000000;
+
+        /**
+         * @brief Number of measures of a case, the fastest one is kept.
+         */
+        int mRepeat = 3;
+
+        /**
+         * @brief Task counts from 10 to the maximum, by factors of 10.
+         *
+         * @param inLimit Upper bound of the case (O(n) operations).
+         * @return std::vector<std::size_t> Task counts.
+         */
+        std::vector<std::size_t> taskCounts(std::size_t inLimit = SIZE_MAX) const {
+            std::vector<std::size_t> counts;
+            for (std::size_t n = 10; n <= mMaxTasks && n <= inLimit; n *= 10) {
+                counts.push_back(n);
+            }
+            return counts;
+        }
+
+        /**
+         * @brief Measures a case.
+         *
+         * @tparam setup_t Callable preparing a measure, not timed.
+         * @tparam body_t Callable running the measured operations.
+         * @param inName Case name.
+         * @param inVariant Case variant (ready queue, callable type).
+         * @param inTasks Task count.
+         * @param inOps Number of operations done by a body call.
+         * @param inSetup Setup function.
+         * @param inBody Body function.
+         */
+        template<typename setup_t, typename body_t>
+        void measure(
+            const std::string& inName,
+            const std::string& inVariant,
+            std::size_t inTasks,
+            std::size_t inOps,
+            setup_t&& inSetup,
+            body_t&& inBody
+        ) {
+            double best = 0;
+
+            for (int i = 0; i < mRepeat; i++) {
+
+                inSetup();
+
+                const auto start = clock_t::now();
+                inBody();
+                const auto stop = clock_t::now();
+
+                const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+
+                if (i == 0 || ns < best) {
+                    best = ns;
+                }
+            }
+
+            mResults.push_back({ inName, inVariant, inTasks, inOps, inOps ? best / inOps : best });
+
+            // progress, the JSON goes to stdout
+            std::cerr << inName << " " << inVariant << " " << inTasks << std::endl;
+        }
+
+        /**
+         * @brief Writes the results as JSON.
+         *
+         * @param inStream Output stream.
+         */
+        void writeJson(std::ostream& inStream) const;
+
+        std::vector<Result> mResults;
+
+    };
+
+    /**
+     * @brief Value sink preventing the compiler from removing the measured work.
+     */
+    extern volatile uint32_t gSink;
+
+    void schedulerBenchmarks(Harness& inHarness);
+
+    void callableBenchmarks(Harness& inHarness);
+
+}
@@ -0,0 +1,71 @@
+#include "harness.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace bench {
+
+    volatile uint32_t gSink = 0;
+
+    void Harness::writeJson(std::ostream& inStream) const {
+
+        inStream << "{\n  \"suite\": \"ucosm\",\n  \"results\": [";
+
+        for (std::size_t i = 0; i < mResults.size(); i++) {
+
+            const auto& r = mResults[i];
+
+            inStream << (i ? ",\n" : "\n")
+                << "    {\"name\": \"" << r.name
+                << "\", \"variant\": \"" << r.variant
+                << "\", \"tasks\": " << r.tasks
+                << ", \"ops\": " << r.ops
+                << ", \"ns_per_op\": " << r.nsPerOp << "}";
+        }
+
+        inStream << "\n  ]\n}\n";
+    }
+
+}
+
+int main(int argc, char** argv) {
+
+    bench::Harness harness;
+
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--max-tasks") && i + 1 < argc) {
+            harness.mMaxTasks = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            harness.mRepeat = std::atoi(argv[++i]);
+        }
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else {
+            std::cerr << "usage: " << argv[0]
+                << " [--max-tasks N] [--repeat N] [--out file.json]\n";
+            return 1;
+        }
+    }
+
+    if (harness.mRepeat < 1) {
+        harness.mRepeat = 1;
+    }
+
+    bench::schedulerBenchmarks(harness);
+    bench::callableBenchmarks(harness);
+
+    if (outPath) {
+        std::ofstream out(outPath);
+        harness.writeJson(out);
+        return out ? 0 : 1;
+    }
+
+    harness.writeJson(std::cout);
+    return 0;
+}
@@ -0,0 +1,398 @@
+#include "harness.hpp"
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/cfs/cfs_scheduler.hpp"
+#include "ucosm/core/pairing_heap.hpp"
+#include "ucosm/core/timing_wheel.hpp"
+#include "ucosm/core/rb_tree.hpp"
+#include "ucosm/rt/rt_scheduler.hpp"
+#include "ucosm/sim/sim_rt_timer.hpp"
+#include "ucosm/edf/edf_scheduler.hpp"
+#include "ucosm/priority/priority_scheduler.hpp"
+#include "ucosm/compact/compact_scheduler.hpp"
+#include "ucosm/static/static_scheduler.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+    uint32_t sClock = 0;
+
+    uint32_t getClock() {
+        return sClock;
+    }
+
+    struct BenchTask : ucosm::IPeriodicTask {
+        void run() override {
+            bench::gSink = bench::gSink + 1;
+        }
+    };
+
+    struct BenchCFSTask : ucosm::ICFSTask {
+        void run() override {
+            // one tick per run
+            sClock++;
+            bench::gSink = bench::gSink + 1;
+        }
+    };
+
+    struct BenchEDFTask : ucosm::IEDFTask {
+        void run() override {
+            bench::gSink = bench::gSink + 1;
+        }
+    };
+
+    struct BenchPriorityTask : ucosm::IPriorityTask {
+        void run() override {
+            bench::gSink = bench::gSink + 1;
+        }
+    };
+
+    struct BenchCompactTask : ucosm::CompactPeriodicTask<BenchCompactTask> {
+        void run() {
+            bench::gSink = bench::gSink + 1;
+        }
+    };
+
+    struct BenchStaticTask : ucosm::IPeriodicTask {
+        BenchStaticTask() : ucosm::IPeriodicTask(4) {}
+        void run() override {
+            bench::gSink = bench::gSink + 1;
+        }
+    };
+
+    struct RTClockTag;
+
+    using rt_clock_t = ucosm::SimClock<RTClockTag>;
+
+    uint32_t nextRandom(uint32_t& ioState) {
+        // xorshift32
+        ioState ^= ioState << 13;
+        ioState ^= ioState >> 17;
+        ioState ^= ioState << 5;
+        return ioState;
+    }
+
+    // number of measured operations for O(n) or O(log n) cases
+    constexpr std::size_t max_ops = 100000;
+
+    template<template<typename> typename queue_t>
+    void periodicBenchmarks(bench::Harness& inHarness, const char* inQueue, std::size_t inLimit) {
+
+        using sched_t = ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, queue_t>;
+
+        {
+            // a single task rescheduled at the same tick
+            auto sched = std::make_unique<sched_t>(getClock);
+            BenchTask task;
+            constexpr std::size_t ops = 1000000;
+
+            inHarness.measure("run_dispatch", inQueue, 1, ops,
+                [&] {
+                    sched->clear();
+                    sClock = 0;
+                    sched->addTask(task);
+                },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        sched->run();
+                    }
+                }
+            );
+
+            sched->clear();
+        }
+
+        for (const auto n : inHarness.taskCounts(inLimit)) {
+
+            std::unique_ptr<BenchTask[]> tasks(new BenchTask[n]);
+            auto sched = std::make_unique<sched_t>(getClock);
+
+            const auto reset = [&] {
+                sched->clear();
+                sClock = 0;
+            };
+
+            const auto fill = [&] {
+                reset();
+                for (std::size_t i = 0; i < n; i++) {
+                    sched->addTask(tasks[i]);
+                }
+            };
+
+            inHarness.measure("add_task", inQueue, n, n, reset, fill);
+
+            const std::size_t ops = std::min(n, max_ops);
+            uint32_t seed = 0x12345678;
+
+            inHarness.measure("set_delay", inQueue, n, ops, fill,
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        const auto r = nextRandom(seed);
+                        sched->setDelay(tasks[r % n], r % 1024);
+                    }
+                }
+            );
+
+            inHarness.measure("remove_task", inQueue, n, n, fill,
+                [&] {
+                    for (std::size_t i = 0; i < n; i++) {
+                        tasks[i].removeTask();
+                    }
+                }
+            );
+
+            // one task due per tick, rescheduled behind all the others
+            inHarness.measure("run", inQueue, n, ops,
+                [&] {
+                    fill();
+                    for (std::size_t i = 0; i < n; i++) {
+                        tasks[i].setPeriod(static_cast<uint32_t>(n));
+                        sched->setDelay(tasks[i], static_cast<uint32_t>(i));
+                    }
+                },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        sClock++;
+                        sched->run();
+                    }
+                }
+            );
+
+            sched->clear();
+        }
+    }
+
+    template<template<typename> typename queue_t>
+    void cfsBenchmarks(bench::Harness& inHarness, const char* inQueue, std::size_t inLimit) {
+
+        using sched_t = ucosm::CFSScheduler<ucosm::ITask<int8_t>, queue_t>;
+
+        for (const auto n : inHarness.taskCounts(inLimit)) {
+
+            std::unique_ptr<BenchCFSTask[]> tasks(new BenchCFSTask[n]);
+            auto sched = std::make_unique<sched_t>(getClock);
+
+            const std::size_t ops = std::min(n * 10, max_ops);
+
+            inHarness.measure("cfs_reinsert", inQueue, n, ops,
+                [&] {
+                    sched->clear();
+                    sClock = 0;
+                    for (std::size_t i = 0; i < n; i++) {
+                        tasks[i].setPriority(static_cast<uint8_t>(i % 4));
+                        sched->addTask(tasks[i]);
+                    }
+                },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        sched->run();
+                    }
+                }
+            );
+
+            sched->clear();
+        }
+    }
+
+    void rtBenchmarks(bench::Harness& inHarness, std::size_t inLimit) {
+
+        using timer_t = ucosm::SimRTTimer<rt_clock_t>;
+
+        for (const auto n : inHarness.taskCounts(inLimit)) {
+
+            std::unique_ptr<BenchTask[]> tasks(new BenchTask[n]);
+            std::unique_ptr<timer_t> timer;
+            std::unique_ptr<ucosm::RTScheduler> sched;
+
+            const std::size_t ops = std::min(n, max_ops);
+
+            // one task due per timer expiry, the timer doesn't sleep
+            inHarness.measure("rt_run", "sorted_list", n, ops,
+                [&] {
+                    if (sched) {
+                        sched->clear();
+                    }
+                    sched.reset();
+                    rt_clock_t::set(0);
+                    timer = std::make_unique<timer_t>();
+                    sched = std::make_unique<ucosm::RTScheduler>();
+                    sched->setTimer(*timer);
+                    for (std::size_t i = 0; i < n; i++) {
+                        tasks[i].setPeriod(static_cast<uint32_t>(n));
+                        sched->addTask(tasks[i], static_cast<uint32_t>(i));
+                    }
+                },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        timer->step();
+                    }
+                }
+            );
+
+            sched->clear();
+            sched.reset();
+        }
+    }
+
+    template<template<typename> typename queue_t>
+    void edfBenchmarks(bench::Harness& inHarness, const char* inQueue, std::size_t inLimit) {
+
+        using sched_t = ucosm::EDFScheduler<ucosm::ITask<int8_t>, queue_t>;
+
+        for (const auto n : inHarness.taskCounts(inLimit)) {
+
+            std::unique_ptr<BenchEDFTask[]> tasks(new BenchEDFTask[n]);
+            auto sched = std::make_unique<sched_t>(getClock);
+
+            const std::size_t ops = std::min(n, max_ops);
+
+            // one release per tick, run at once
+            inHarness.measure("edf_run", inQueue, n, ops,
+                [&] {
+                    sched->clear();
+                    sClock = 0;
+                    for (std::size_t i = 0; i < n; i++) {
+                        tasks[i].setPeriod(static_cast<uint32_t>(n));
+                        tasks[i].setOffset(static_cast<uint32_t>(i));
+                        sched->addTask(tasks[i]);
+                    }
+                },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        sched->run();
+                        sClock++;
+                    }
+                }
+            );
+
+            sched->clear();
+        }
+    }
+
+    void priorityBenchmarks(bench::Harness& inHarness) {
+
+        using sched_t = ucosm::PriorityScheduler<>;
+
+        for (const auto n : inHarness.taskCounts()) {
+
+            std::unique_ptr<BenchPriorityTask[]> tasks(new BenchPriorityTask[n]);
+            auto sched = std::make_unique<sched_t>();
+
+            const std::size_t ops = std::min(n * 10, max_ops);
+
+            // round robin in the highest level, spread over every level
+            inHarness.measure("priority_run", "level_queue", n, ops,
+                [&] {
+                    sched->clear();
+                    for (std::size_t i = 0; i < n; i++) {
+                        tasks[i].setPriority(static_cast<uint8_t>(i % 32));
+                        sched->addTask(tasks[i]);
+                    }
+                },
+                [&] {
+                    for (std::size_t i = 0; i < ops; i++) {
+                        sched->run();
+                    }
+                }
+            );
+
+            sched->clear();
+        }
+    }
+
+    template<std::size_t capacity>
+    void compactBenchmark(bench::Harness& inHarness) {
+
+        using sched_t = ucosm::CompactScheduler<BenchCompactTask, capacity>;
+
+        if (capacity > inHarness.mMaxTasks) {
+            return;
+        }
+
+        std::unique_ptr<sched_t> sched;
+
+        const std::size_t ops = std::min(capacity, max_ops);
+
+        // the pool lives in the scheduler, which is rebuilt for each measure
+        inHarness.measure("compact_run", "index_list", capacity, ops,
+            [&] {
+                sClock = 0;
+                sched = std::make_unique<sched_t>(getClock);
+                for (std::size_t i = 0; i < capacity; i++) {
+                    auto& task = (*sched)[i];
+                    task.setPeriod(static_cast<uint32_t>(capacity));
+                    sched->addTask(task);
+                    sched->setDelay(task, static_cast<uint32_t>(i));
+                }
+            },
+            [&] {
+                for (std::size_t i = 0; i < ops; i++) {
+                    sClock++;
+                    sched->run();
+                }
+            }
+        );
+    }
+
+    void staticBenchmarks(bench::Harness& inHarness) {
+
+        using sched_t = ucosm::StaticScheduler<BenchStaticTask, BenchStaticTask, BenchStaticTask, BenchStaticTask>;
+
+        std::unique_ptr<sched_t> sched;
+        constexpr std::size_t ops = 1000000;
+
+        // one task due per tick, no virtual dispatch
+        inHarness.measure("static_run", "tuple", sched_t::task_count, ops,
+            [&] {
+                sClock = 0;
+                sched = std::make_unique<sched_t>(getClock);
+                sched->addTasks();
+                sched->setDelay<1>(1);
+                sched->setDelay<2>(2);
+                sched->setDelay<3>(3);
+            },
+            [&] {
+                for (std::size_t i = 0; i < ops; i++) {
+                    sched->run();
+                    sClock++;
+                }
+            }
+        );
+    }
+
+}
+
+namespace bench {
+
+    void schedulerBenchmarks(Harness& inHarness) {
+
+        // the sorted list reschedules in O(n)
+        constexpr std::size_t list_limit = 10000;
+
+        periodicBenchmarks<ucosm::SortedList>(inHarness, "sorted_list", list_limit);
+        periodicBenchmarks<ucosm::PairingHeap>(inHarness, "pairing_heap", SIZE_MAX);
+        periodicBenchmarks<ucosm::TimingWheel>(inHarness, "timing_wheel", SIZE_MAX);
+        periodicBenchmarks<ucosm::RBTree>(inHarness, "rb_tree", SIZE_MAX);
+
+        cfsBenchmarks<ucosm::SortedList>(inHarness, "sorted_list", list_limit);
+        cfsBenchmarks<ucosm::PairingHeap>(inHarness, "pairing_heap", SIZE_MAX);
+        cfsBenchmarks<ucosm::RBTree>(inHarness, "rb_tree", SIZE_MAX);
+
+        rtBenchmarks(inHarness, list_limit);
+
+        edfBenchmarks<ucosm::SortedList>(inHarness, "sorted_list", list_limit);
+        edfBenchmarks<ucosm::PairingHeap>(inHarness, "pairing_heap", SIZE_MAX);
+
+        priorityBenchmarks(inHarness);
+
+        compactBenchmark<10>(inHarness);
+        compactBenchmark<100>(inHarness);
+        compactBenchmark<1000>(inHarness);
+        compactBenchmark<10000>(inHarness);
+
+        staticBenchmarks(inHarness);
+    }
+
+}
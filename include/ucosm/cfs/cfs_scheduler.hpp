@@ -28,22 +28,32 @@
 #pragma once
 
 #include "ucosm/core/ischeduler.hpp"
+#include "ucosm/core/rb_tree.hpp"
 #include "icfs_task.hpp"
 
 namespace ucosm {
 
     /**
      * @brief Completely fair scheduler.
+     * Tasks are ordered by weighted execution time in a red-black tree
+     * timeline by default.
      *
      * @tparam sched_task_t Scheduler task type
+     * @tparam queue_t Ready queue type (RBTree, SortedList, PairingHeap,
+     * FixedRankTable<N>::type)
+     * @tparam stats_t Statistics policy (NoStats, StatsTable<N>)
      */
-    template<typename sched_task_t = ITask<int8_t>>
-    struct CFSScheduler : IScheduler<ICFSTask, sched_task_t> {
+    template<
+        typename sched_task_t = ITask<int8_t>,
+        template<typename> typename queue_t = RBTree,
+        typename stats_t = NoStats
+    >
+    struct CFSScheduler : IScheduler<ICFSTask, sched_task_t, queue_t, stats_t> {
 
         using get_tick_t = ICFSTask::tick_t(*)();
 
         CFSScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
-            IScheduler<ICFSTask, sched_task_t>(inIdleTask),
+            IScheduler<ICFSTask, sched_task_t, queue_t, stats_t>(inIdleTask),
             mGetTick(inGetTick) {}
 
         /**
@@ -57,27 +67,36 @@ namespace ucosm {
 
     };
 
-    template<typename sched_rank_t>
-    void CFSScheduler<sched_rank_t>::run() {
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void CFSScheduler<sched_task_t, queue_t, stats_t>::run() {
+
+        this->drainInbox();
 
         this->mCurrentTask = this->getNextTask();
 
         if (!this->mCurrentTask) {
             // no task to run
-            if (this->mIdleTask) {
-                this->mIdleTask();
-            }
+            this->idle();
             return;
         }
 
         const auto startTimeStamp = mGetTick();
         const auto currentRank = this->mCurrentTask->getRank();
 
-        this->mCursorTask.setRank(currentRank);
+        this->mTasks.setCursor(currentRank);
+        this->trace(TraceEvent::TaskStart, this->mCurrentTask);
         this->mCurrentTask->run();
+        this->trace(TraceEvent::TaskStop, this->mCurrentTask);
 
-        // Check if task is still linked after execution
-        if (this->mCurrentTask->isLinked()) {
+        if constexpr (stats_t::enabled) {
+            // ranks are execution times, not due times
+            this->recordRun(*this->mCurrentTask, mGetTick() - startTimeStamp, 0);
+        }
+
+        if (this->isParked(*this->mCurrentTask)) {
+            // the task waits for resume()
+        }
+        else if (this->mCurrentTask->isLinked()) {
 
             auto taskDuration = mGetTick() - startTimeStamp;
 
@@ -87,6 +106,9 @@ namespace ucosm {
             this->mCurrentTask->setRank(taskDuration);
             this->sortTask(*this->mCurrentTask);
         }
+        else {
+            this->recordRemove(*this->mCurrentTask);
+        }
 
         this->mCurrentTask = nullptr;
     }
@@ -0,0 +1,322 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/ischeduler.hpp"
+#include "compact_task.hpp"
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Periodic scheduler owning a pool of compact tasks.
+     *
+     * Tasks are stored in an array and linked by indices in a list kept
+     * sorted relative to the last executed rank, with the PeriodicScheduler
+     * rules. The list sentinel is the index equal to the capacity.
+     *
+     * @tparam task_t Task type, derived from CompactPeriodicTask.
+     * @tparam capacity Number of tasks in the pool.
+     * @tparam sched_task_t Scheduler task type
+     */
+    template<typename task_t, std::size_t capacity, typename sched_task_t = ITask<int8_t>>
+    struct CompactScheduler : sched_task_t {
+
+        using index_t = typename task_t::index_t;
+
+        using tick_t = typename task_t::tick_t;
+
+        using get_tick_t = tick_t(*)();
+
+        CompactScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
+            mGetTick(inGetTick),
+            mIdleTask(inIdleTask) {}
+
+        CompactScheduler(const CompactScheduler&) = delete;
+        CompactScheduler& operator=(const CompactScheduler&) = delete;
+
+        /**
+         * @brief Returns a task of the pool.
+         *
+         * @param inIndex Task index.
+         * @return task_t& Task instance.
+         */
+        task_t& operator[](std::size_t inIndex) { return mPool[inIndex]; }
+
+        /**
+         * @brief Returns the index of a task of the pool.
+         *
+         * @param inTask Task instance.
+         * @return std::size_t Task index.
+         */
+        std::size_t indexOf(const task_t& inTask) const { return &inTask - mPool; }
+
+        /**
+         * @brief Adds a task of the pool to the scheduler.
+         *
+         * @param inTask Task instance.
+         * @return true if the task was successfully added.
+         * @return false otherwise.
+         */
+        bool addTask(task_t& inTask);
+
+        /**
+         * @brief Delay the task.
+         *
+         * @param inDelay Delay value.
+         */
+        void setDelay(task_t& inTask, tick_t inDelay);
+
+        /**
+         * @brief Updates the task position in the list according to its rank value.
+         *
+         * @return true if the task was moved in the list
+         * @return false otherwise.
+         */
+        bool updateRank(task_t& inTask);
+
+        /**
+         * @brief Runs the next ready tasks.
+         */
+        void run() override;
+
+        /**
+         * @brief Returns the currently executed task.
+         *
+         * @return task_t* Pointer to the task.
+         */
+        task_t* thisTask() { return mCurrentTask; }
+
+        /**
+         * @brief Returns the number of task in the scheduler.
+         * This function will traverse the task list in order to count them.
+         *
+         * @return std::size_t Number of task.
+         */
+        std::size_t size() const;
+
+        bool empty() const { return size() == 0; }
+
+        void setIdleTask(idle_task_t inIdleTask) { mIdleTask = inIdleTask; }
+
+    private:
+
+        static_assert(capacity < task_t::removed_bit, "capacity too large for the index type");
+
+        static constexpr index_t sentinel = capacity;
+
+        index_t& next(index_t inIndex) {
+            return (inIndex == sentinel) ? mFirst : mPool[inIndex].mNext;
+        }
+
+        index_t prev(index_t inIndex) const {
+            return (inIndex == sentinel) ? mLast : (mPool[inIndex].mPrev & ~task_t::removed_bit);
+        }
+
+        void setPrev(index_t inIndex, index_t inPrev) {
+            if (inIndex == sentinel) {
+                mLast = inPrev;
+            }
+            else {
+                // keep the removed mark
+                auto& link = mPool[inIndex].mPrev;
+                link = inPrev | (link & task_t::removed_bit);
+            }
+        }
+
+        tick_t delta(index_t inIndex) const {
+            return mPool[inIndex].mRank - mCursor;
+        }
+
+        void unlink(index_t inIndex);
+
+        void insert(index_t inIndex);
+
+        task_t mPool[capacity];
+
+        index_t mFirst = sentinel;
+        index_t mLast = sentinel;
+
+        tick_t mCursor = 0;
+
+        get_tick_t mGetTick;
+
+        idle_task_t mIdleTask;
+
+        task_t* mCurrentTask = nullptr;
+
+    };
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    bool CompactScheduler<task_t, capacity, sched_task_t>::addTask(task_t& inTask) {
+
+        if (inTask.isLinked()) {
+            return false;
+        }
+
+        const index_t index = static_cast<index_t>(indexOf(inTask));
+
+        if (inTask.isRemoved()) {
+            // still in the list
+            unlink(index);
+        }
+
+        if (!inTask.init()) {
+            return false;
+        }
+
+        inTask.mRank = mCursor;
+        insert(index);
+        return true;
+    }
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    void CompactScheduler<task_t, capacity, sched_task_t>::setDelay(
+        task_t& inTask,
+        tick_t inDelay
+    ) {
+        inTask.mRank = mGetTick() + inDelay;
+        updateRank(inTask);
+    }
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    bool CompactScheduler<task_t, capacity, sched_task_t>::updateRank(task_t& inTask) {
+
+        if (!inTask.isLinked()) {
+            return false;
+        }
+
+        const index_t index = static_cast<index_t>(indexOf(inTask));
+        const index_t p = prev(index);
+        const index_t n = next(index);
+
+        if (
+            (p == sentinel || delta(p) <= delta(index)) &&
+            (n == sentinel || delta(index) <= delta(n))
+        ) {
+            // already in place
+            return false;
+        }
+
+        unlink(index);
+        insert(index);
+        return true;
+    }
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    void CompactScheduler<task_t, capacity, sched_task_t>::run() {
+
+        // removed tasks are unlinked when they reach the front
+        while (mFirst != sentinel && mPool[mFirst].isRemoved()) {
+            unlink(mFirst);
+        }
+
+        if (mFirst == sentinel) {
+            if (mIdleTask) {
+                mIdleTask();
+            }
+            return;
+        }
+
+        const index_t index = mFirst;
+        auto& task = mPool[index];
+
+        const tick_t tick = mGetTick();
+        const tick_t deltaTask = task.mRank - mCursor;
+        const tick_t deltaTick = tick - mCursor;
+
+        if (deltaTick < deltaTask) {
+            // task is not ready
+            if (mIdleTask) {
+                mIdleTask();
+            }
+            return;
+        }
+
+        mCurrentTask = &task;
+        mCursor = task.mRank;
+        task.run();
+
+        if (task.isRemoved()) {
+            unlink(index);
+        }
+        else if (task.isLinked()) {
+            task.mRank = tick + task.mPeriod;
+            updateRank(task);
+        }
+
+        mCurrentTask = nullptr;
+    }
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    std::size_t CompactScheduler<task_t, capacity, sched_task_t>::size() const {
+
+        std::size_t count = 0;
+
+        for (index_t i = mFirst; i != sentinel; i = mPool[i].mNext) {
+            count += mPool[i].isLinked();
+        }
+
+        return count;
+    }
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    void CompactScheduler<task_t, capacity, sched_task_t>::unlink(index_t inIndex) {
+
+        const index_t p = prev(inIndex);
+        const index_t n = next(inIndex);
+
+        next(p) = n;
+        setPrev(n, p);
+
+        mPool[inIndex].mPrev = task_t::no_index;
+        mPool[inIndex].mNext = task_t::no_index;
+    }
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    void CompactScheduler<task_t, capacity, sched_task_t>::insert(index_t inIndex) {
+
+        // ranks are compared relative to the cursor to handle overflows
+        // walk from the back, equal ranks keep their insertion order
+        const tick_t d = delta(inIndex);
+
+        index_t pos = mLast;
+
+        while (pos != sentinel && delta(pos) > d) {
+            pos = prev(pos);
+        }
+
+        const index_t n = next(pos);
+
+        mPool[inIndex].mPrev = pos;
+        mPool[inIndex].mNext = n;
+        next(pos) = inIndex;
+        setPrev(n, inIndex);
+    }
+
+}
@@ -0,0 +1,153 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace ucosm {
+
+    template<typename task_t, std::size_t capacity, typename sched_task_t>
+    struct CompactScheduler;
+
+    /**
+     * @brief Periodic task linked by indices into the pool of a CompactScheduler.
+     *
+     * The node holds two index links, the rank and the period, without
+     * virtual functions: 12 bytes with 16 bits indices. The scheduler calls
+     * the derived class run(), init() and deinit() directly.
+     * As the task can't reach its pool, removeTask() only marks the task,
+     * which is unlinked by the scheduler after its execution or when it
+     * reaches the front of the list.
+     *
+     * @tparam derived_t Derived task type.
+     * @tparam index_t Unsigned index type (uint16_t or uint32_t).
+     */
+    template<typename derived_t, typename _index_t = uint16_t>
+    struct CompactPeriodicTask {
+
+        using index_t = _index_t;
+
+        using tick_t = uint32_t;
+
+        static_assert(std::is_unsigned_v<index_t>, "index type must be unsigned");
+
+        CompactPeriodicTask(tick_t inPeriod = 0) :
+            mPeriod(inPeriod) {}
+
+        /**
+         * @brief Initializes the task.
+         * Called by the scheduler when the task is added.
+         *
+         * @return true if the task was successfully initialized.
+         * @return false otherwise.
+         */
+        bool init() { return true; }
+
+        /**
+         * @brief Deinitializes the task.
+         * Called when the task is removed.
+         */
+        void deinit() {}
+
+        /**
+         * @brief Removes the task from the scheduler.
+         */
+        void removeTask();
+
+        /**
+         * @brief Tells if the task is held by a scheduler.
+         *
+         * @return true if the task is linked.
+         * @return false otherwise.
+         */
+        bool isLinked() const;
+
+        /**
+         * @brief Set the task period.
+         *
+         * @param inPeriod Period value.
+         */
+        void setPeriod(tick_t inPeriod) { mPeriod = inPeriod; }
+
+        /**
+         * @brief Get the task period.
+         *
+         * @return tick_t Period  value.
+         */
+        tick_t getPeriod() const { return mPeriod; }
+
+        /**
+         * @brief Sets the task rank value.
+         *
+         * @param inRank inRank New rank value.
+         */
+        void setRank(tick_t inRank) { mRank = inRank; }
+
+        /**
+         * @brief Gets the task rank value.
+         *
+         * @return tick_t Rank value.
+         */
+        tick_t getRank() const { return mRank; }
+
+    private:
+
+        template<typename task_t, std::size_t capacity, typename sched_task_t>
+        friend struct CompactScheduler;
+
+        static constexpr index_t no_index = std::numeric_limits<index_t>::max();
+
+        // set in the previous link of a removed task still in the list
+        static constexpr index_t removed_bit = no_index ^ (no_index >> 1);
+
+        bool isRemoved() const { return mNext != no_index && (mPrev & removed_bit); }
+
+        index_t mPrev = no_index;
+        index_t mNext = no_index;
+        tick_t mRank = 0;
+        tick_t mPeriod;
+
+    };
+
+    template<typename derived_t, typename index_t>
+    void CompactPeriodicTask<derived_t, index_t>::removeTask() {
+        if (this->isLinked()) {
+            static_cast<derived_t*>(this)->deinit();
+            mPrev |= removed_bit;
+        }
+    }
+
+    template<typename derived_t, typename index_t>
+    bool CompactPeriodicTask<derived_t, index_t>::isLinked() const {
+        return mNext != no_index && !(mPrev & removed_bit);
+    }
+
+}
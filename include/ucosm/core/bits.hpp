@@ -0,0 +1,83 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ucosm::bits {
+
+    /**
+     * @brief Index of the least significant bit set.
+     *
+     * @param inValue Non zero value.
+     * @return uint8_t Bit index.
+     */
+    inline uint8_t lsb(uint64_t inValue) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint8_t>(__builtin_ctzll(inValue));
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, inValue);
+        return static_cast<uint8_t>(index);
+#else
+        uint8_t index = 0;
+        while (!(inValue & 1)) {
+            inValue >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    /**
+     * @brief Index of the most significant bit set.
+     *
+     * @param inValue Non zero value.
+     * @return uint8_t Bit index.
+     */
+    inline uint8_t msb(uint64_t inValue) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint8_t>(63 - __builtin_clzll(inValue));
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanReverse64(&index, inValue);
+        return static_cast<uint8_t>(index);
+#else
+        uint8_t index = 0;
+        while (inValue >>= 1) {
+            index++;
+        }
+        return index;
+#endif
+    }
+
+}
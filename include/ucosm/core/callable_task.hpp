@@ -68,7 +68,7 @@ namespace ucosm {
      * @tparam task_t Task implementation
      */
     template<typename task_t>
-    struct CallableTask final : task_t {
+    struct CallableTask : task_t {
 
         CallableTask() = default;
 
@@ -151,8 +151,6 @@ namespace ucosm {
             return *this;
         }
 
-    private:
-
         void run() override {
             if (mOps) {
                 mOps->invoke(mStorage);
@@ -162,6 +160,8 @@ namespace ucosm {
             }
         }
 
+    private:
+
         struct Operations {
             void(*invoke)(const std::byte*);
             void (*destroy)(std::byte*);
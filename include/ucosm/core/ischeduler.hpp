@@ -29,6 +29,13 @@
 
 #include "ulink.hpp"
 #include "itask.hpp"
+#include "iwakeup.hpp"
+#include "sorted_list.hpp"
+#include "task_inbox.hpp"
+#include "task_stats.hpp"
+#include "trace_ring.hpp"
+#include <cstddef>
+#include <type_traits>
 
 namespace ucosm {
 
@@ -39,9 +46,17 @@ namespace ucosm {
      *
      * @tparam task_t Task type to schedule.
      * @tparam sched_task_t Scheduler task type
+     * @tparam queue_t Ready queue type (SortedList, PairingHeap, TimingWheel, RBTree,
+     * FixedRankTable<N>::type)
+     * @tparam stats_t Statistics policy (NoStats, StatsTable<N>)
      */
-    template<typename task_t, typename sched_task_t>
-    struct IScheduler : sched_task_t {
+    template<
+        typename task_t,
+        typename sched_task_t,
+        template<typename> typename queue_t = SortedList,
+        typename stats_t = NoStats
+    >
+    struct IScheduler : sched_task_t, private stats_t {
 
         /**
          * @brief Construct a new scheduler object.
@@ -49,9 +64,7 @@ namespace ucosm {
          * @param inIdleTask Function to execute when there is no task to run.
          */
         IScheduler(idle_task_t inIdleTask = nullptr) :
-            mIdleTask(inIdleTask) {
-            mTasks.push_front(mCursorTask);
-        }
+            mIdleTask(inIdleTask) {}
 
         /**
          * @brief Adds a task to the scheduler.
@@ -62,6 +75,65 @@ namespace ucosm {
          */
         virtual bool addTask(task_t& inTask);
 
+        /**
+         * @brief Adds a range of tasks to the scheduler in a single pass.
+         * The tasks are initialized and linked after the cursor in the
+         * order of the range, so they run in this order. Tasks that don't
+         * fit in a fixed capacity queue are not added.
+         *
+         * @tparam iterator_t Iterator on tasks or on task pointers.
+         * @tparam mask_iterator_t Output iterator receiving one bool per task.
+         * @param inFirst First task.
+         * @param inLast End of the range.
+         * @param outMask Set to true for each task that was added.
+         * @return std::size_t Number of added tasks.
+         */
+        template<typename iterator_t, typename mask_iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast, mask_iterator_t outMask);
+
+        /**
+         * @brief Adds a range of tasks to the scheduler in a single pass.
+         *
+         * @tparam iterator_t Iterator on tasks or on task pointers.
+         * @param inFirst First task.
+         * @param inLast End of the range.
+         * @return std::size_t Number of added tasks.
+         */
+        template<typename iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast) {
+            return addTasks(inFirst, inLast, DiscardMask {});
+        }
+
+        /**
+         * @brief Posts a task to be added by the scheduler thread.
+         * Can be called from any thread, the task is added by addTask()
+         * at the start of the next run. The task must not be linked nor
+         * already posted, and must outlive the post.
+         *
+         * @param inTask Task instance.
+         */
+        void post(task_t& inTask);
+
+        /**
+         * @brief Takes a task out of the ready queue without deinitializing it.
+         * Must be called from the scheduler thread, typically by the task
+         * itself. The parked task doesn't run until resume() is called, it
+         * is still held by the scheduler and counted by size() and empty(),
+         * and removeTask() deinitializes it.
+         *
+         * @param inTask Task held by the scheduler.
+         */
+        void park(task_t& inTask);
+
+        /**
+         * @brief Makes a parked task ready again.
+         * Can be called from any thread, the task is pushed back at the
+         * cursor rank at the start of the next run, as by a null delay.
+         *
+         * @param inTask Parked task, must not be resumed twice.
+         */
+        void resume(task_t& inTask);
+
         /**
          * @brief Returns the currently executed task.
          *
@@ -70,7 +142,7 @@ namespace ucosm {
         task_t* thisTask();
 
         /**
-         * @brief Returns the number of task in the scheduler.
+         * @brief Returns the number of task in the scheduler, parked tasks included.
          * This function will traverse the task list in order to count them.
          * This function might perform poorly if the scheduler contains a lot of tasks.
          *
@@ -79,7 +151,7 @@ namespace ucosm {
         std::size_t size() const;
 
         /**
-         * @brief Tells if the scheduler contains any task.
+         * @brief Tells if the scheduler contains any task, parked tasks included.
          *
          * @return true if the scheduler doesn't contain any task.
          * @return false otherwise.
@@ -98,6 +170,28 @@ namespace ucosm {
          */
         void setIdleTask(idle_task_t inIdleTask);
 
+        /**
+         * @brief Set the wake-up notified when tasks are added or delayed.
+         *
+         * @param inWakeup Wake-up instance, nullptr to remove it.
+         */
+        void setWakeup(IWakeup* inWakeup);
+
+        /**
+         * @brief Wakes up the thread sleeping in the scheduler loop, if any.
+         * The task list itself is not thread-safe: tasks added from another
+         * thread must be synchronized with the loop by the caller.
+         */
+        void notify();
+
+        /**
+         * @brief Set the ring recording the scheduling events.
+         * The ring must only be written by the thread running the scheduler.
+         *
+         * @param inTrace Trace ring, nullptr to stop tracing.
+         */
+        void setTrace(TraceRing* inTrace);
+
         /**
          * @brief Pushes task names into a given stream.
          *
@@ -108,6 +202,38 @@ namespace ucosm {
         template<typename stream_t>
         void list(stream_t&& inStream, std::string_view inSeparator = "\n");
 
+        /**
+         * @brief Calls a function with each task of the scheduler that
+         * has statistics. Requires a statistics policy.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking a task_t reference and a
+         * const TaskStats reference.
+         */
+        template<typename func_t>
+        void forEachStats(func_t&& inFunc);
+
+        /**
+         * @brief Returns the statistics of a task. Requires a statistics policy.
+         *
+         * @param inTask Task instance.
+         * @return const TaskStats* Task statistics, nullptr if the task was never recorded.
+         */
+        const TaskStats* statsOf(const task_t& inTask) const;
+
+        /**
+         * @brief Clears the statistics of every task. Requires a statistics policy.
+         */
+        void resetStats();
+
+        /**
+         * @brief Returns the number of runs that didn't fit in the statistics
+         * table. Requires a statistics policy.
+         *
+         * @return uint32_t Number of runs.
+         */
+        uint32_t droppedStats() const;
+
         /**
          * @brief Get the rank of the next task to be run.
          *
@@ -119,33 +245,100 @@ namespace ucosm {
 
         using task_rank_t = typename task_t::rank_t;
         using itask_t = ITask<task_rank_t>;
-        using const_task_iterator = typename ulink::List<itask_t>::const_iterator;
 
         bool sortTask(itask_t& inTask);
 
         task_t* getNextTask();
 
-        ulink::List<itask_t> mTasks;
+        /**
+         * @brief Takes a task out of the ready queue, without counting it
+         * as parked nor deinitializing it.
+         *
+         * @param inTask Task held by the scheduler.
+         */
+        void detach(itask_t& inTask);
+
+        /**
+         * @brief Tells if a task was parked and not resumed yet.
+         *
+         * @param inTask Task instance.
+         * @return true if the task is parked.
+         * @return false otherwise.
+         */
+        bool isParked(const itask_t& inTask) const;
+
+        /**
+         * @brief Adds the posted and resumed tasks, called at the start of a run.
+         */
+        void drainInbox();
+
+        /**
+         * @brief Records a task run, compiled out without statistics policy.
+         *
+         * @param inTask Executed task.
+         * @param inTicks Execution duration.
+         * @param inLateness Start tick minus due tick.
+         */
+        void recordRun(task_t& inTask, TaskStats::tick_t inTicks, TaskStats::tick_t inLateness);
+
+        /**
+         * @brief Records the removal of a task and forgets its statistics.
+         *
+         * @param inTask Removed task.
+         */
+        void recordRemove(itask_t& inTask);
+
+        /**
+         * @brief Records a scheduling event if a trace ring is set.
+         *
+         * @param inEvent Event kind.
+         * @param inTask Task concerned by the event, if any.
+         * @param inValue Event value.
+         */
+        void trace(TraceEvent inEvent, itask_t* inTask = nullptr, uint32_t inValue = 0);
+
+        /**
+         * @brief Records the idle entry and calls the idle function.
+         */
+        void idle();
+
+        queue_t<itask_t> mTasks;
+
+        TaskInbox<itask_t> mInbox;
+
+        TaskInbox<itask_t> mResumed;
+
+        // parked tasks, linked to be counted and removable
+        ulink::List<itask_t> mParked;
 
         idle_task_t mIdleTask;
 
+        IWakeup* mWakeup = nullptr;
+
+        TraceRing* mTrace = nullptr;
+
+        bool mIdle = false;
+
         task_t* mCurrentTask = nullptr;
 
-        struct CursorTask final : itask_t {
-            void run() override {}
-            std::string_view name() override { return ">"; }
-            auto* next() { return static_cast<task_t*>(this->itask_t::next); }
-            const auto* next() const { return static_cast<const task_t*>(this->itask_t::next); }
+    private:
+
+        struct DiscardMask {
+            DiscardMask& operator*() { return *this; }
+            DiscardMask& operator++() { return *this; }
+            DiscardMask& operator=(bool) { return *this; }
         };
 
-        CursorTask mCursorTask;
+        static void unlinkParked(itask_t& inTask);
+
+        void forgetStats(itask_t& inTask);
 
     };
 
-    template<typename task_t, typename sched_rank_t>
-    bool IScheduler<task_t, sched_rank_t>::addTask(task_t& inTask) {
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    bool IScheduler<task_t, sched_task_t, queue_t, stats_t>::addTask(task_t& inTask) {
         // Check if task is already linked to prevent double-adding
-        if (inTask.isLinked()) {
+        if (inTask.isLinked() || !mTasks.available()) {
             return false;
         }
 
@@ -153,113 +346,309 @@ namespace ucosm {
             return false;
         }
 
-        mTasks.insert_after(&mCursorTask, inTask);
-        inTask.setRank(mCursorTask.getRank());
-        this->sortTask(inTask);
+        // a previous task may have lived at this address
+        forgetStats(inTask);
+
+        inTask.setRank(mTasks.getCursor());
+        mTasks.push(inTask);
+        trace(TraceEvent::TaskAdd, &inTask);
+        notify();
         return true;
     }
 
-    template<typename task_t, typename sched_rank_t>
-    task_t* IScheduler<task_t, sched_rank_t>::thisTask() {
-        return static_cast<task_t*>(mCurrentTask);
-    }
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    template<typename iterator_t, typename mask_iterator_t>
+    std::size_t IScheduler<task_t, sched_task_t, queue_t, stats_t>::addTasks(
+        iterator_t inFirst,
+        iterator_t inLast,
+        mask_iterator_t outMask
+    ) {
 
-    template<typename task_t, typename sched_rank_t>
-    bool IScheduler<task_t, sched_rank_t>::empty() const {
-        return (&mTasks.front() == &mTasks.back());
-    }
+        // tasks are staged in an intrusive list before being merged
+        ulink::List<itask_t> batch;
+        std::size_t count = 0;
+        const std::size_t room = mTasks.available();
 
-    template<typename task_t, typename sched_rank_t>
-    void IScheduler<task_t, sched_rank_t>::clear() {
-        mTasks.clear();
-        mTasks.push_front(mCursorTask);
+        for (; inFirst != inLast; ++inFirst, ++outMask) {
+
+            task_t* task;
+
+            if constexpr (std::is_pointer_v<std::decay_t<decltype(*inFirst)>>) {
+                task = *inFirst;
+            }
+            else {
+                task = &(*inFirst);
+            }
+
+            const bool added = (count < room) && !task->isLinked() && task->init();
+
+            *outMask = added;
+
+            if (added) {
+                forgetStats(*task);
+                task->setRank(mTasks.getCursor());
+                batch.push_back(*task);
+                trace(TraceEvent::TaskAdd, task);
+                count++;
+            }
+        }
+
+        // every task of the batch ranks at the cursor
+        mTasks.push(batch);
+
+        if (count) {
+            notify();
+        }
+
+        return count;
     }
 
-    template<typename task_t, typename sched_rank_t>
-    std::size_t IScheduler<task_t, sched_rank_t>::size() const {
-        return (mTasks.size() - 1);
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::post(task_t& inTask) {
+        mInbox.push(inTask);
+        notify();
     }
 
-    template<typename task_t, typename sched_rank_t>
-    void IScheduler<task_t, sched_rank_t>::setIdleTask(idle_task_t inIdleTask) {
-        mIdleTask = inIdleTask;
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::park(task_t& inTask) {
+        inTask.unlink();
+        mParked.push_back(inTask);
+        inTask.mUnlink = &unlinkParked;
+        trace(TraceEvent::TaskPark, &inTask);
     }
 
-    template<typename task_t, typename sched_rank_t>
-    template<typename stream_t>
-    void IScheduler<task_t, sched_rank_t>::list(
-        stream_t&& inStream,
-        std::string_view inSeparator
-    ) {
-        for (auto& t : mTasks) {
-            inStream << t.name() << inSeparator;
-        }
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::resume(task_t& inTask) {
+        mResumed.push(inTask);
+        notify();
     }
 
-    template<typename task_t, typename sched_rank_t>
-    typename task_t::rank_t IScheduler<task_t, sched_rank_t>::getNextRank() const {
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::drainInbox() {
+
+        mInbox.drain(
+            [this] (itask_t& inTask) {
+                this->addTask(static_cast<task_t&>(inTask));
+            }
+        );
+
+        mResumed.drain(
+            [this] (itask_t& inTask) {
+
+                if (!isParked(inTask)) {
+                    // removed while it was parked
+                    return;
+                }
+
+                if (!mTasks.available()) {
+                    // fixed capacity queue full, retry on the next run
+                    mResumed.push(inTask);
+                    return;
+                }
+
+                inTask.unlink();
+                inTask.setRank(mTasks.getCursor());
+                mTasks.push(inTask);
+                trace(TraceEvent::TaskResume, &inTask);
+            }
+        );
+    }
 
-        auto& front = mTasks.front();
-        auto& back = mTasks.back();
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    task_t* IScheduler<task_t, sched_task_t, queue_t, stats_t>::thisTask() {
+        return static_cast<task_t*>(mCurrentTask);
+    }
 
-        if (&front == &back) {
-            // only the cursor task is in the list
-            return 0;
-        }
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    bool IScheduler<task_t, sched_task_t, queue_t, stats_t>::empty() const {
+        return mTasks.empty() && mParked.empty();
+    }
 
-        if (&this->mCursorTask == &back) {
-            return this->mTasks.front().getRank();
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::clear() {
+        if (mTrace || stats_t::enabled) {
+            mTasks.forEach(
+                [this] (itask_t& t) {
+                    recordRemove(t);
+                }
+            );
+            for (auto& t : mParked) {
+                recordRemove(t);
+            }
         }
-        else {
-            return this->mCursorTask.next()->getRank();
+        mTasks.clear();
+        while (!mParked.empty()) {
+            mParked.front().unlink();
         }
+    }
 
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    std::size_t IScheduler<task_t, sched_task_t, queue_t, stats_t>::size() const {
+        return mTasks.size() + mParked.size();
     }
 
-    template<typename task_t, typename sched_rank_t>
-    task_t* IScheduler<task_t, sched_rank_t>::getNextTask() {
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::setIdleTask(idle_task_t inIdleTask) {
+        mIdleTask = inIdleTask;
+    }
 
-        auto& front = mTasks.front();
-        auto& back = mTasks.back();
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::setWakeup(IWakeup* inWakeup) {
+        mWakeup = inWakeup;
+    }
 
-        if (&front == &back) {
-            // only the cursor task is in the list
-            return nullptr;
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::notify() {
+        if (mWakeup) {
+            mWakeup->notify();
         }
+    }
 
-        if (&mCursorTask == &back) {
-            // cursor is last
-            // update cursor
-            mTasks.push_front(mCursorTask);
-            return static_cast<task_t*>(&front);
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::setTrace(TraceRing* inTrace) {
+        mTrace = inTrace;
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::trace(
+        TraceEvent inEvent,
+        itask_t* inTask,
+        uint32_t inValue
+    ) {
+        if (mTrace) {
+
+            if (inEvent == TraceEvent::Idle) {
+                if (mIdle) {
+                    // only the idle entry is recorded
+                    return;
+                }
+                mIdle = true;
+            }
+            else {
+                mIdle = false;
+            }
+
+            mTrace->record(inEvent, inTask ? inTask->name() : std::string_view(), inValue);
         }
-        else {
-            return mCursorTask.next();
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::idle() {
+        trace(TraceEvent::Idle);
+        if (mIdleTask) {
+            mIdleTask();
         }
+    }
 
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    template<typename stream_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::list(
+        stream_t&& inStream,
+        std::string_view inSeparator
+    ) {
+        mTasks.forEach(
+            [&] (itask_t& t) {
+                inStream << t.name() << inSeparator;
+            }
+        );
     }
 
-    template<typename task_t, typename sched_rank_t>
-    bool IScheduler<task_t, sched_rank_t>::sortTask(itask_t& inTask) {
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    template<typename func_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::forEachStats(func_t&& inFunc) {
+        static_assert(stats_t::enabled, "no statistics policy");
+        mTasks.forEach(
+            [&] (itask_t& t) {
+                if (const auto* stats = stats_t::findRecord(&t)) {
+                    inFunc(static_cast<task_t&>(t), *stats);
+                }
+            }
+        );
+    }
 
-        const auto rank = inTask.getRank();
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    const TaskStats* IScheduler<task_t, sched_task_t, queue_t, stats_t>::statsOf(const task_t& inTask) const {
+        static_assert(stats_t::enabled, "no statistics policy");
+        return stats_t::findRecord(static_cast<const itask_t*>(&inTask));
+    }
 
-        if (rank < mTasks.front().getRank()) {
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::resetStats() {
+        static_assert(stats_t::enabled, "no statistics policy");
+        stats_t::reset();
+    }
 
-            mTasks.push_front(inTask);
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    uint32_t IScheduler<task_t, sched_task_t, queue_t, stats_t>::droppedStats() const {
+        static_assert(stats_t::enabled, "no statistics policy");
+        return stats_t::dropped();
+    }
 
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::recordRun(
+        task_t& inTask,
+        TaskStats::tick_t inTicks,
+        TaskStats::tick_t inLateness
+    ) {
+        if constexpr (stats_t::enabled) {
+            if (auto* stats = stats_t::recordOf(static_cast<itask_t*>(&inTask))) {
+                stats->record(inTicks, inLateness);
+            }
         }
-        else if (rank > mTasks.back().getRank()) {
+    }
 
-            mTasks.push_back(inTask);
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::recordRemove(itask_t& inTask) {
+        forgetStats(inTask);
+        trace(TraceEvent::TaskRemove, &inTask);
+    }
 
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::forgetStats(itask_t& inTask) {
+        if constexpr (stats_t::enabled) {
+            stats_t::forget(&inTask);
         }
-        else {
-            return inTask.updateRank();
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    typename task_t::rank_t IScheduler<task_t, sched_task_t, queue_t, stats_t>::getNextRank() const {
+
+        if (const auto* next = mTasks.peek()) {
+            return next->getRank();
         }
 
-        return true;
+        // the scheduler is empty
+        return 0;
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    task_t* IScheduler<task_t, sched_task_t, queue_t, stats_t>::getNextTask() {
+        return static_cast<task_t*>(mTasks.next());
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    bool IScheduler<task_t, sched_task_t, queue_t, stats_t>::sortTask(itask_t& inTask) {
+        if (isParked(inTask)) {
+            // not in the ready queue
+            return false;
+        }
+        return mTasks.sort(inTask);
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::detach(itask_t& inTask) {
+        inTask.unlink();
+    }
+
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    bool IScheduler<task_t, sched_task_t, queue_t, stats_t>::isParked(const itask_t& inTask) const {
+        return inTask.mUnlink == &unlinkParked;
+    }
 
+    template<typename task_t, typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void IScheduler<task_t, sched_task_t, queue_t, stats_t>::unlinkParked(itask_t& inTask) {
+        inTask.mUnlink = nullptr;
+        inTask.remove();
     }
 
 }
\ No newline at end of file
@@ -29,9 +29,39 @@
 
 #include "ulink.hpp"
 #include <string_view>
+#include <cstddef>
 
 namespace ucosm {
 
+    template<typename itask_t>
+    struct PairingHeap;
+
+    template<typename itask_t>
+    struct TimingWheel;
+
+    template<typename itask_t>
+    struct RBTree;
+
+    template<typename itask_t, std::size_t capacity>
+    struct RankTable;
+
+    template<typename itask_t, std::size_t level_count>
+    struct LevelQueue;
+
+    template<typename itask_t>
+    struct TaskInbox;
+
+    template<typename sched_task_t, typename ... tasks_t>
+    struct BasicStaticScheduler;
+
+    template<
+        typename task_t,
+        typename sched_task_t,
+        template<typename> typename queue_t,
+        typename stats_t
+    >
+    struct IScheduler;
+
     /**
      * @brief Task interface.
      *
@@ -42,6 +72,8 @@ namespace ucosm {
 
         using rank_t = _rank_t;
 
+        ~ITask() { unlink(); }
+
         /**
          * @brief Runs the task.
          * Typically called by the scheduler when the task is ready.
@@ -68,6 +100,14 @@ namespace ucosm {
          */
         void removeTask();
 
+        /**
+         * @brief Tells if the task is held by a scheduler.
+         *
+         * @return true if the task is linked.
+         * @return false otherwise.
+         */
+        bool isLinked() const;
+
         /**
          * @brief Returns the name of the task.
          *
@@ -77,6 +117,7 @@ namespace ucosm {
 
         /**
          * @brief Updates the task position in the list according to its rank value.
+         * Only applies to tasks held by a list based ready queue.
          *
          * @return true if the task was moved in the list
          * @return false otherwise.
@@ -102,9 +143,48 @@ namespace ucosm {
         template<typename T>
         friend class ulink::List;
 
+        template<typename itask_t>
+        friend struct PairingHeap;
+
+        template<typename itask_t>
+        friend struct TimingWheel;
+
+        template<typename itask_t>
+        friend struct RBTree;
+
+        template<typename itask_t, std::size_t capacity>
+        friend struct RankTable;
+
+        template<typename itask_t, std::size_t level_count>
+        friend struct LevelQueue;
+
+        template<typename itask_t>
+        friend struct TaskInbox;
+
+        template<typename sched_task_t, typename ... tasks_t>
+        friend struct BasicStaticScheduler;
+
+        template<
+            typename task_t,
+            typename sched_task_t,
+            template<typename> typename queue_t,
+            typename stats_t
+        >
+        friend struct IScheduler;
+
         using ulink::Node<ITask<rank_t>>::remove;
 
+        using unlink_t = void(*)(ITask&);
+
+        void unlink();
+
         rank_t mRank = rank_t();
+
+        // extra link and unlink function, set by tree shaped ready queues
+        // the extra link also chains the tasks of an inbox and the unlink
+        // function marks parked tasks, so every queue needs them
+        ITask* mChild = nullptr;
+        unlink_t mUnlink = nullptr;
     };
 
     template<typename rank_t>
@@ -112,7 +192,22 @@ namespace ucosm {
         if (this->isLinked()) {
             deinit();
         }
-        ulink::Node<ITask<rank_t>>::remove();
+        unlink();
+    }
+
+    template<typename rank_t>
+    bool ITask<rank_t>::isLinked() const {
+        return mUnlink || ulink::Node<ITask<rank_t>>::isLinked();
+    }
+
+    template<typename rank_t>
+    void ITask<rank_t>::unlink() {
+        if (mUnlink) {
+            mUnlink(*this);
+        }
+        else {
+            ulink::Node<ITask<rank_t>>::remove();
+        }
     }
 
     template<typename rank_t>
@@ -128,7 +223,7 @@ namespace ucosm {
     template<typename rank_t>
     bool ITask<rank_t>::updateRank() {
 
-        if (!this->isLinked()) {
+        if (mUnlink || !ulink::Node<ITask<rank_t>>::isLinked()) {
             return false;
         }
 
@@ -0,0 +1,266 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include "bits.hpp"
+#include <stdint.h>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace ucosm {
+
+    /**
+     * @brief Ready queue keeping tasks in one FIFO per priority level.
+     *
+     * The rank of a task is its level, 0 being the highest, ranks beyond
+     * the last level go to the last one. Ranks aren't relative to the
+     * cursor, which is only kept for the scheduler interface. A bitmap
+     * flags the non empty levels, the next task is the front of the
+     * lowest flagged level, found with a count trailing zeros.
+     * Sorting a task moves it to the back of its level, which gives a
+     * round robin among the tasks of a level.
+     *
+     * Insertion, removal and picking the next task are O(1).
+     *
+     * @tparam itask_t Task interface type.
+     * @tparam level_count Number of levels, up to 64.
+     */
+    template<typename itask_t, std::size_t level_count>
+    struct LevelQueue {
+
+        static_assert(level_count > 0 && level_count <= 64, "1 to 64 levels");
+
+        using rank_t = typename itask_t::rank_t;
+
+        LevelQueue() { mAnchor.mQueue = this; }
+        LevelQueue(const LevelQueue&) = delete;
+        LevelQueue& operator=(const LevelQueue&) = delete;
+
+        ~LevelQueue() { clear(); }
+
+        /**
+         * @brief Get the rank of the last task picked.
+         *
+         * @return rank_t Cursor rank.
+         */
+        rank_t getCursor() const { return mCursor; }
+
+        /**
+         * @brief Set the rank of the last task picked, doesn't change the order.
+         *
+         * @param inRank Cursor rank.
+         */
+        void setCursor(rank_t inRank) { mCursor = inRank; }
+
+        /**
+         * @brief Inserts a task at the back of its level.
+         *
+         * @param inTask Unlinked task.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Inserts a batch of tasks, in order.
+         *
+         * @param inBatch List of tasks, emptied by the call.
+         */
+        void push(ulink::List<itask_t>& inBatch);
+
+        /**
+         * @brief Moves a task to the back of the level of its updated rank.
+         *
+         * @param inTask Task to sort.
+         * @return true if the task was moved.
+         * @return false if the task isn't in the queue.
+         */
+        bool sort(itask_t& inTask);
+
+        /**
+         * @brief Returns the first task of the highest priority level.
+         *
+         * @return itask_t* Next task or nullptr if the queue is empty.
+         */
+        itask_t* next();
+
+        /**
+         * @brief Returns the first task of the highest priority level.
+         *
+         * @return const itask_t* Next task or nullptr if the queue is empty.
+         */
+        const itask_t* peek() const {
+            return const_cast<LevelQueue*>(this)->next();
+        }
+
+        bool empty() const { return mCount == 0; }
+
+        std::size_t size() const { return mCount; }
+
+        /**
+         * @brief Returns the number of tasks that can still be pushed.
+         *
+         * @return std::size_t Free slot count.
+         */
+        std::size_t available() const { return std::numeric_limits<std::size_t>::max(); }
+
+        void clear();
+
+        /**
+         * @brief Calls a function on each task of the queue, level by level.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void forEach(func_t&& inFunc);
+
+    private:
+
+        using bitmap_t = std::conditional_t<(level_count > 32), uint64_t, uint32_t>;
+
+        // tasks of the queue point to it through their child link
+        struct AnchorTask final : itask_t {
+            void run() override {}
+            LevelQueue* mQueue = nullptr;
+        };
+
+        static void unlink(itask_t& inTask);
+
+        ulink::List<itask_t> mLevels[level_count];
+
+        // a set bit might refer to a level that has been emptied since
+        bitmap_t mReady = 0;
+
+        std::size_t mCount = 0;
+
+        // not used to order the tasks, only kept for the ready queue interface
+        rank_t mCursor = rank_t();
+
+        AnchorTask mAnchor;
+
+    };
+
+    /**
+     * @brief Binds the level count of a LevelQueue to use it as ready queue.
+     *
+     * @tparam level_count Number of levels.
+     */
+    template<std::size_t level_count>
+    struct FixedLevelQueue {
+        template<typename itask_t>
+        using type = LevelQueue<itask_t, level_count>;
+    };
+
+    template<typename itask_t, std::size_t level_count>
+    void LevelQueue<itask_t, level_count>::push(itask_t& inTask) {
+
+        inTask.mChild = &mAnchor;
+        inTask.mUnlink = &LevelQueue::unlink;
+
+        const std::size_t level = (inTask.mRank < level_count) ? inTask.mRank : level_count - 1;
+
+        mLevels[level].push_back(inTask);
+        mReady |= bitmap_t(1) << level;
+        mCount++;
+    }
+
+    template<typename itask_t, std::size_t level_count>
+    void LevelQueue<itask_t, level_count>::push(ulink::List<itask_t>& inBatch) {
+        while (!inBatch.empty()) {
+            auto& t = inBatch.front();
+            t.ulink::Node<itask_t>::remove();
+            push(t);
+        }
+    }
+
+    template<typename itask_t, std::size_t level_count>
+    bool LevelQueue<itask_t, level_count>::sort(itask_t& inTask) {
+
+        if (inTask.mChild != &mAnchor) {
+            return false;
+        }
+
+        unlink(inTask);
+        push(inTask);
+        return true;
+    }
+
+    template<typename itask_t, std::size_t level_count>
+    itask_t* LevelQueue<itask_t, level_count>::next() {
+
+        while (mReady) {
+
+            const uint8_t level = bits::lsb(mReady);
+
+            if (!mLevels[level].empty()) {
+                return &mLevels[level].front();
+            }
+
+            // emptied by a removal
+            mReady &= mReady - 1;
+        }
+
+        return nullptr;
+    }
+
+    template<typename itask_t, std::size_t level_count>
+    void LevelQueue<itask_t, level_count>::clear() {
+
+        for (auto& level : mLevels) {
+            while (!level.empty()) {
+                unlink(level.front());
+            }
+        }
+
+        mReady = 0;
+    }
+
+    template<typename itask_t, std::size_t level_count>
+    template<typename func_t>
+    void LevelQueue<itask_t, level_count>::forEach(func_t&& inFunc) {
+        for (auto& level : mLevels) {
+            for (auto& t : level) {
+                inFunc(t);
+            }
+        }
+    }
+
+    template<typename itask_t, std::size_t level_count>
+    void LevelQueue<itask_t, level_count>::unlink(itask_t& inTask) {
+
+        auto* queue = static_cast<AnchorTask*>(inTask.mChild)->mQueue;
+
+        inTask.ulink::Node<itask_t>::remove();
+        inTask.mChild = nullptr;
+        inTask.mUnlink = nullptr;
+
+        queue->mCount--;
+    }
+
+}
\ No newline at end of file
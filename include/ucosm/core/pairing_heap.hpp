@@ -0,0 +1,355 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include <cstddef>
+#include <limits>
+
+namespace ucosm {
+
+    /**
+     * @brief Ready queue keeping tasks in an intrusive pairing heap.
+     * Ranks are compared relative to the cursor, which makes the ordering
+     * wrap safe as long as every rank lies ahead of the cursor.
+     * Insertion is O(1), rescheduling and removal are O(log n) amortized,
+     * picking the next task is O(1). No memory is allocated.
+     *
+     * Node links:
+     * - child : first child
+     * - next  : next sibling
+     * - prev  : previous sibling, or parent for a first child
+     *
+     * @tparam itask_t Task interface type.
+     */
+    template<typename itask_t>
+    struct PairingHeap {
+
+        using rank_t = typename itask_t::rank_t;
+
+        PairingHeap() = default;
+        PairingHeap(const PairingHeap&) = delete;
+        PairingHeap& operator=(const PairingHeap&) = delete;
+
+        ~PairingHeap() { clear(); }
+
+        /**
+         * @brief Get the rank of the last task picked.
+         *
+         * @return rank_t Cursor rank.
+         */
+        rank_t getCursor() const { return mCursor; }
+
+        /**
+         * @brief Set the rank of the last task picked.
+         *
+         * @param inRank Cursor rank.
+         */
+        void setCursor(rank_t inRank) { mCursor = inRank; }
+
+        /**
+         * @brief Inserts a task according to its rank.
+         *
+         * @param inTask Unlinked task.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Inserts a batch of tasks ranked at the cursor.
+         *
+         * @param inBatch List of tasks, emptied by the call.
+         */
+        void push(ulink::List<itask_t>& inBatch);
+
+        /**
+         * @brief Moves a task according to its updated rank.
+         *
+         * @param inTask Task to sort.
+         * @return true if the task was moved.
+         * @return false if the task isn't in the heap.
+         */
+        bool sort(itask_t& inTask);
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return itask_t* Next task or nullptr if the queue is empty.
+         */
+        itask_t* next() { return mRoot.mChild; }
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return const itask_t* Next task or nullptr if the queue is empty.
+         */
+        const itask_t* peek() const { return mRoot.mChild; }
+
+        bool empty() const { return !mRoot.mChild; }
+
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the number of tasks that can still be pushed.
+         *
+         * @return std::size_t Free slot count.
+         */
+        std::size_t available() const { return std::numeric_limits<std::size_t>::max(); }
+
+        void clear();
+
+        /**
+         * @brief Calls a function on each task of the queue.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void forEach(func_t&& inFunc);
+
+    private:
+
+        // permanent root, its only child is the actual heap root
+        struct RootTask final : itask_t {
+            void run() override {}
+        };
+
+        static bool less(const itask_t& a, const itask_t& b, rank_t inRef) {
+            return static_cast<rank_t>(a.mRank - inRef) < static_cast<rank_t>(b.mRank - inRef);
+        }
+
+        static itask_t* meld(itask_t* a, itask_t* b, rank_t inRef);
+
+        static itask_t* mergePairs(itask_t* inFirst, rank_t inRef);
+
+        static void detach(itask_t& inTask, rank_t inRef);
+
+        static void unlink(itask_t& inTask) {
+            // the children of a task never rank before it
+            detach(inTask, inTask.mRank);
+        }
+
+        template<typename func_t>
+        void traverse(func_t&& inFunc) const;
+
+        RootTask mRoot;
+
+        rank_t mCursor = rank_t();
+
+    };
+
+    template<typename itask_t>
+    void PairingHeap<itask_t>::push(itask_t& inTask) {
+
+        inTask.mChild = nullptr;
+        inTask.next = nullptr;
+        inTask.prev = nullptr;
+        inTask.mUnlink = &PairingHeap::unlink;
+
+        itask_t* root = &inTask;
+
+        if (mRoot.mChild) {
+            root = meld(mRoot.mChild, &inTask, mCursor);
+        }
+
+        root->prev = &mRoot;
+        root->next = nullptr;
+        mRoot.mChild = root;
+    }
+
+    template<typename itask_t>
+    void PairingHeap<itask_t>::push(ulink::List<itask_t>& inBatch) {
+        while (!inBatch.empty()) {
+            auto& t = inBatch.front();
+            t.ulink::Node<itask_t>::remove();
+            push(t);
+        }
+    }
+
+    template<typename itask_t>
+    bool PairingHeap<itask_t>::sort(itask_t& inTask) {
+
+        if (inTask.mUnlink != &PairingHeap::unlink) {
+            return false;
+        }
+
+        // the task rank has already changed : its children are
+        // merged relatively to the cursor
+        detach(inTask, mCursor);
+        push(inTask);
+        return true;
+    }
+
+    template<typename itask_t>
+    itask_t* PairingHeap<itask_t>::meld(itask_t* a, itask_t* b, rank_t inRef) {
+
+        if (less(*b, *a, inRef)) {
+            auto* t = a;
+            a = b;
+            b = t;
+        }
+
+        // b becomes the first child of a
+        b->next = a->mChild;
+        if (b->next) {
+            b->next->prev = b;
+        }
+        b->prev = a;
+        a->mChild = b;
+
+        return a;
+    }
+
+    template<typename itask_t>
+    itask_t* PairingHeap<itask_t>::mergePairs(itask_t* inFirst, rank_t inRef) {
+
+        if (!inFirst) {
+            return nullptr;
+        }
+
+        // first pass : meld siblings by pairs from left to right,
+        // the results are stacked in reverse order through next
+        itask_t* stack = nullptr;
+
+        while (inFirst) {
+            itask_t* a = inFirst;
+            itask_t* b = a->next;
+
+            if (b) {
+                inFirst = b->next;
+                a = meld(a, b, inRef);
+            }
+            else {
+                inFirst = nullptr;
+            }
+
+            a->next = stack;
+            stack = a;
+        }
+
+        // second pass : meld the pairs from right to left
+        itask_t* root = stack;
+        stack = stack->next;
+
+        while (stack) {
+            itask_t* n = stack->next;
+            root = meld(root, stack, inRef);
+            stack = n;
+        }
+
+        root->next = nullptr;
+        return root;
+    }
+
+    template<typename itask_t>
+    void PairingHeap<itask_t>::detach(itask_t& inTask, rank_t inRef) {
+
+        itask_t* prev = inTask.prev;
+        itask_t* next = inTask.next;
+        itask_t* sub = mergePairs(inTask.mChild, inRef);
+
+        // the merged children take the place of the task
+        itask_t* replacement = next;
+
+        if (sub) {
+            sub->prev = prev;
+            sub->next = next;
+            replacement = sub;
+        }
+
+        if (next) {
+            next->prev = sub ? sub : prev;
+        }
+
+        if (prev->mChild == &inTask) {
+            prev->mChild = replacement;
+        }
+        else {
+            prev->next = replacement;
+        }
+
+        inTask.mChild = nullptr;
+        inTask.next = nullptr;
+        inTask.prev = nullptr;
+        inTask.mUnlink = nullptr;
+    }
+
+    template<typename itask_t>
+    std::size_t PairingHeap<itask_t>::size() const {
+        std::size_t count = 0;
+        traverse([&count] (itask_t&) { count++; });
+        return count;
+    }
+
+    template<typename itask_t>
+    void PairingHeap<itask_t>::clear() {
+        while (mRoot.mChild) {
+            unlink(*mRoot.mChild);
+        }
+    }
+
+    template<typename itask_t>
+    template<typename func_t>
+    void PairingHeap<itask_t>::forEach(func_t&& inFunc) {
+        traverse(inFunc);
+    }
+
+    template<typename itask_t>
+    template<typename func_t>
+    void PairingHeap<itask_t>::traverse(func_t&& inFunc) const {
+
+        // depth first walk without stack : climbing uses the prev links
+        itask_t* t = mRoot.mChild;
+
+        while (t) {
+
+            inFunc(*t);
+
+            if (t->mChild) {
+                t = t->mChild;
+                continue;
+            }
+
+            while (t && !t->next) {
+                // go back to the parent
+                while (t->prev->mChild != t) {
+                    t = t->prev;
+                }
+                t = t->prev;
+
+                if (t == &mRoot) {
+                    t = nullptr;
+                }
+            }
+
+            if (t) {
+                t = t->next;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,217 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "bits.hpp"
+#include <stdint.h>
+#include <cstddef>
+
+#if !defined(UCOSM_NO_SIMD) && defined(__AVX2__)
+#define UCOSM_RANKS_AVX2
+#include <immintrin.h>
+#elif !defined(UCOSM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define UCOSM_RANKS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ucosm::ranks {
+
+    /**
+     * @brief Index of the lowest rank relative to a cursor.
+     * The first index is returned if several ranks are equal.
+     *
+     * @param inRanks Rank array.
+     * @param inCount Number of ranks, not zero.
+     * @param inCursor Reference rank.
+     * @return std::size_t Rank index.
+     */
+    template<typename rank_t>
+    std::size_t lowestScalar(const rank_t* inRanks, std::size_t inCount, rank_t inCursor) {
+
+        std::size_t index = 0;
+        rank_t low = static_cast<rank_t>(inRanks[0] - inCursor);
+
+        for (std::size_t i = 1; i < inCount; i++) {
+            const rank_t delta = static_cast<rank_t>(inRanks[i] - inCursor);
+            if (delta < low) {
+                low = delta;
+                index = i;
+            }
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief Index of the lowest rank relative to a cursor.
+     *
+     * @param inRanks Rank array.
+     * @param inCount Number of ranks, not zero.
+     * @param inCursor Reference rank.
+     * @return std::size_t Rank index.
+     */
+    template<typename rank_t>
+    std::size_t lowest(const rank_t* inRanks, std::size_t inCount, rank_t inCursor) {
+        return lowestScalar(inRanks, inCount, inCursor);
+    }
+
+#if defined(UCOSM_RANKS_AVX2)
+
+    /**
+     * @brief AVX2 version of lowest() for 32 bits ranks.
+     * A first pass computes the lowest delta, a second one finds its
+     * first occurrence.
+     */
+    inline std::size_t lowestAvx2(const uint32_t* inRanks, std::size_t inCount, uint32_t inCursor) {
+
+        constexpr std::size_t lane_count = 8;
+
+        const __m256i cursor = _mm256_set1_epi32(static_cast<int>(inCursor));
+        __m256i low = _mm256_set1_epi32(-1);
+
+        std::size_t i = 0;
+
+        for (; i + lane_count <= inCount; i += lane_count) {
+            const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inRanks + i));
+            low = _mm256_min_epu32(low, _mm256_sub_epi32(r, cursor));
+        }
+
+        alignas(32) uint32_t lanes[lane_count];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), low);
+
+        uint32_t lowest = lanes[0];
+
+        for (std::size_t l = 1; l < lane_count; l++) {
+            lowest = (lanes[l] < lowest) ? lanes[l] : lowest;
+        }
+
+        for (; i < inCount; i++) {
+            const uint32_t delta = inRanks[i] - inCursor;
+            lowest = (delta < lowest) ? delta : lowest;
+        }
+
+        const __m256i target = _mm256_set1_epi32(static_cast<int>(lowest));
+
+        for (i = 0; i + lane_count <= inCount; i += lane_count) {
+            const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inRanks + i));
+            const __m256i eq = _mm256_cmpeq_epi32(_mm256_sub_epi32(r, cursor), target);
+            const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+            if (mask) {
+                return i + bits::lsb(static_cast<uint64_t>(mask));
+            }
+        }
+
+        while (static_cast<uint32_t>(inRanks[i] - inCursor) != lowest) {
+            i++;
+        }
+
+        return i;
+    }
+
+#elif defined(UCOSM_RANKS_SSE2)
+
+    /**
+     * @brief SSE2 version of lowest() for 32 bits ranks.
+     * SSE2 only compares signed values, flipping the sign bit of the
+     * deltas keeps their unsigned order.
+     */
+    inline std::size_t lowestSse2(const uint32_t* inRanks, std::size_t inCount, uint32_t inCursor) {
+
+        constexpr std::size_t lane_count = 4;
+
+        const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i cursor = _mm_set1_epi32(static_cast<int>(inCursor));
+        __m128i low = _mm_set1_epi32(0x7FFFFFFF);
+
+        std::size_t i = 0;
+
+        for (; i + lane_count <= inCount; i += lane_count) {
+            const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inRanks + i));
+            const __m128i delta = _mm_xor_si128(_mm_sub_epi32(r, cursor), sign);
+            const __m128i lt = _mm_cmplt_epi32(delta, low);
+            low = _mm_or_si128(_mm_and_si128(lt, delta), _mm_andnot_si128(lt, low));
+        }
+
+        alignas(16) uint32_t lanes[lane_count];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(low, sign));
+
+        uint32_t lowest = lanes[0];
+
+        for (std::size_t l = 1; l < lane_count; l++) {
+            lowest = (lanes[l] < lowest) ? lanes[l] : lowest;
+        }
+
+        for (; i < inCount; i++) {
+            const uint32_t delta = inRanks[i] - inCursor;
+            lowest = (delta < lowest) ? delta : lowest;
+        }
+
+        const __m128i target = _mm_set1_epi32(static_cast<int>(lowest));
+
+        for (i = 0; i + lane_count <= inCount; i += lane_count) {
+            const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inRanks + i));
+            const __m128i eq = _mm_cmpeq_epi32(_mm_sub_epi32(r, cursor), target);
+            const int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+            if (mask) {
+                return i + bits::lsb(static_cast<uint64_t>(mask));
+            }
+        }
+
+        while (static_cast<uint32_t>(inRanks[i] - inCursor) != lowest) {
+            i++;
+        }
+
+        return i;
+    }
+
+#endif
+
+    /**
+     * @brief Index of the lowest 32 bits rank relative to a cursor,
+     * vectorized with AVX2 or SSE2 when available.
+     * The first index is returned if several ranks are equal.
+     *
+     * @param inRanks Rank array.
+     * @param inCount Number of ranks, not zero.
+     * @param inCursor Reference rank.
+     * @return std::size_t Rank index.
+     */
+    inline std::size_t lowest(const uint32_t* inRanks, std::size_t inCount, uint32_t inCursor) {
+#if defined(UCOSM_RANKS_AVX2)
+        if (inCount >= 8) {
+            return lowestAvx2(inRanks, inCount, inCursor);
+        }
+#elif defined(UCOSM_RANKS_SSE2)
+        if (inCount >= 4) {
+            return lowestSse2(inRanks, inCount, inCursor);
+        }
+#endif
+        return lowestScalar(inRanks, inCount, inCursor);
+    }
+
+}
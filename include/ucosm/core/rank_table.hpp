@@ -0,0 +1,300 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include "rank_search.hpp"
+#include <stdint.h>
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Fixed capacity ready queue storing ranks in a contiguous array.
+     *
+     * Ranks are copied in an aligned array with a parallel array of task
+     * pointers, the next task is found by a linear search of the lowest
+     * rank relative to the cursor, vectorized for 32 bits ranks (see
+     * ranks::lowest). Removing a task moves the last one in its slot, so
+     * tasks with equal ranks run in slot order.
+     *
+     * Suited to schedulers of up to a few hundred tasks.
+     *
+     * @tparam itask_t Task interface type.
+     * @tparam capacity Maximum number of tasks.
+     */
+    template<typename itask_t, std::size_t capacity>
+    struct RankTable {
+
+        static_assert(capacity > 0, "null capacity");
+
+        using rank_t = typename itask_t::rank_t;
+
+        RankTable() { mAnchor.mTable = this; }
+        RankTable(const RankTable&) = delete;
+        RankTable& operator=(const RankTable&) = delete;
+
+        ~RankTable() { clear(); }
+
+        /**
+         * @brief Get the rank of the last task picked.
+         *
+         * @return rank_t Cursor rank.
+         */
+        rank_t getCursor() const { return mCursor; }
+
+        /**
+         * @brief Set the rank of the last task picked.
+         *
+         * @param inRank Cursor rank.
+         */
+        void setCursor(rank_t inRank);
+
+        /**
+         * @brief Inserts a task, the table must not be full.
+         *
+         * @param inTask Unlinked task.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Inserts a batch of tasks ranked at the cursor.
+         *
+         * @param inBatch List of tasks, emptied by the call.
+         */
+        void push(ulink::List<itask_t>& inBatch);
+
+        /**
+         * @brief Updates the stored rank of a task.
+         *
+         * @param inTask Task to sort.
+         * @return true if the task was updated.
+         * @return false if the task isn't in the table.
+         */
+        bool sort(itask_t& inTask);
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return itask_t* Next task or nullptr if the queue is empty.
+         */
+        itask_t* next();
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return const itask_t* Next task or nullptr if the queue is empty.
+         */
+        const itask_t* peek() const {
+            return const_cast<RankTable*>(this)->next();
+        }
+
+        bool empty() const { return mCount == 0; }
+
+        std::size_t size() const { return mCount; }
+
+        /**
+         * @brief Returns the number of tasks that can still be pushed.
+         *
+         * @return std::size_t Free slot count.
+         */
+        std::size_t available() const { return capacity - mCount; }
+
+        void clear();
+
+        /**
+         * @brief Calls a function on each task of the queue.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void forEach(func_t&& inFunc);
+
+    private:
+
+        static constexpr std::size_t no_index = capacity;
+
+        // tasks of the table point to it through their child link
+        struct AnchorTask final : itask_t {
+            void run() override {}
+            RankTable* mTable = nullptr;
+        };
+
+        std::size_t indexOf(const itask_t& inTask) const;
+
+        void erase(std::size_t inIndex);
+
+        static void unlink(itask_t& inTask);
+
+        alignas(32) rank_t mRanks[capacity];
+        itask_t* mTasks[capacity];
+
+        std::size_t mCount = 0;
+
+        // index of the lowest rank, no_index if unknown
+        std::size_t mNext = no_index;
+
+        // index of the last task picked, speeds up sort
+        std::size_t mLast = no_index;
+
+        rank_t mCursor = rank_t();
+
+        AnchorTask mAnchor;
+
+    };
+
+    /**
+     * @brief Binds the capacity of a RankTable to use it as ready queue.
+     *
+     * @tparam capacity Maximum number of tasks.
+     */
+    template<std::size_t capacity>
+    struct FixedRankTable {
+        template<typename itask_t>
+        using type = RankTable<itask_t, capacity>;
+    };
+
+    template<typename itask_t, std::size_t capacity>
+    void RankTable<itask_t, capacity>::setCursor(rank_t inRank) {
+        mCursor = inRank;
+        // deltas are relative to the cursor
+        mNext = no_index;
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    void RankTable<itask_t, capacity>::push(itask_t& inTask) {
+
+        inTask.mChild = &mAnchor;
+        inTask.mUnlink = &RankTable::unlink;
+
+        mRanks[mCount] = inTask.mRank;
+        mTasks[mCount] = &inTask;
+
+        if (
+            mNext != no_index &&
+            static_cast<rank_t>(inTask.mRank - mCursor) <
+            static_cast<rank_t>(mRanks[mNext] - mCursor)
+        ) {
+            mNext = mCount;
+        }
+
+        mCount++;
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    void RankTable<itask_t, capacity>::push(ulink::List<itask_t>& inBatch) {
+        while (!inBatch.empty()) {
+            auto& t = inBatch.front();
+            t.ulink::Node<itask_t>::remove();
+            push(t);
+        }
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    bool RankTable<itask_t, capacity>::sort(itask_t& inTask) {
+
+        if (inTask.mChild != &mAnchor) {
+            return false;
+        }
+
+        const auto index = indexOf(inTask);
+        mRanks[index] = inTask.mRank;
+        mNext = no_index;
+        return true;
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    itask_t* RankTable<itask_t, capacity>::next() {
+
+        if (!mCount) {
+            return nullptr;
+        }
+
+        if (mNext == no_index) {
+            mNext = ranks::lowest(mRanks, mCount, mCursor);
+        }
+
+        mLast = mNext;
+        return mTasks[mNext];
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    void RankTable<itask_t, capacity>::clear() {
+        while (mCount) {
+            unlink(*mTasks[mCount - 1]);
+        }
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    template<typename func_t>
+    void RankTable<itask_t, capacity>::forEach(func_t&& inFunc) {
+        for (std::size_t i = 0; i < mCount; i++) {
+            inFunc(*mTasks[i]);
+        }
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    std::size_t RankTable<itask_t, capacity>::indexOf(const itask_t& inTask) const {
+
+        if (mLast < mCount && mTasks[mLast] == &inTask) {
+            return mLast;
+        }
+
+        std::size_t index = 0;
+        while (mTasks[index] != &inTask) {
+            index++;
+        }
+        return index;
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    void RankTable<itask_t, capacity>::erase(std::size_t inIndex) {
+
+        mCount--;
+
+        // the last task takes the free slot
+        mRanks[inIndex] = mRanks[mCount];
+        mTasks[inIndex] = mTasks[mCount];
+
+        mNext = no_index;
+        mLast = no_index;
+    }
+
+    template<typename itask_t, std::size_t capacity>
+    void RankTable<itask_t, capacity>::unlink(itask_t& inTask) {
+
+        auto* table = static_cast<AnchorTask*>(inTask.mChild)->mTable;
+
+        table->erase(table->indexOf(inTask));
+
+        inTask.mChild = nullptr;
+        inTask.mUnlink = nullptr;
+    }
+
+}
@@ -0,0 +1,553 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include <stdint.h>
+#include <cstddef>
+#include <limits>
+
+namespace ucosm {
+
+    /**
+     * @brief Ready queue keeping tasks in an intrusive red-black tree.
+     * The leftmost node is cached, like the Linux CFS timeline, so picking
+     * the next task is O(1) while insertion and removal are O(log n).
+     * Ranks are compared relative to the cursor, which makes the ordering
+     * wrap safe as long as every rank lies ahead of the cursor.
+     * Tasks of equal rank are picked in insertion order.
+     *
+     * Node links:
+     * - prev  : left child
+     * - next  : right child
+     * - child : parent, the lowest bit holds the color
+     *
+     * @tparam itask_t Task interface type.
+     */
+    template<typename itask_t>
+    struct RBTree {
+
+        using rank_t = typename itask_t::rank_t;
+
+        RBTree() { mHeader.mTree = this; }
+        RBTree(const RBTree&) = delete;
+        RBTree& operator=(const RBTree&) = delete;
+
+        ~RBTree() { clear(); }
+
+        /**
+         * @brief Get the rank of the last task picked.
+         *
+         * @return rank_t Cursor rank.
+         */
+        rank_t getCursor() const { return mCursor; }
+
+        /**
+         * @brief Set the rank of the last task picked.
+         *
+         * @param inRank Cursor rank.
+         */
+        void setCursor(rank_t inRank) { mCursor = inRank; }
+
+        /**
+         * @brief Inserts a task according to its rank.
+         *
+         * @param inTask Unlinked task.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Inserts a batch of tasks ranked at the cursor.
+         *
+         * @param inBatch List of tasks, emptied by the call.
+         */
+        void push(ulink::List<itask_t>& inBatch);
+
+        /**
+         * @brief Moves a task according to its updated rank.
+         *
+         * @param inTask Task to sort.
+         * @return true if the task was moved.
+         * @return false if the task isn't in the tree.
+         */
+        bool sort(itask_t& inTask);
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return itask_t* Next task or nullptr if the queue is empty.
+         */
+        itask_t* next() { return mLeftmost; }
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return const itask_t* Next task or nullptr if the queue is empty.
+         */
+        const itask_t* peek() const { return mLeftmost; }
+
+        bool empty() const { return !mRoot; }
+
+        std::size_t size() const { return mCount; }
+
+        /**
+         * @brief Returns the number of tasks that can still be pushed.
+         *
+         * @return std::size_t Free slot count.
+         */
+        std::size_t available() const { return std::numeric_limits<std::size_t>::max(); }
+
+        void clear();
+
+        /**
+         * @brief Calls a function on each task of the queue in rank order.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void forEach(func_t&& inFunc);
+
+    private:
+
+        // parent of the root node
+        struct HeaderTask final : itask_t {
+            void run() override {}
+            RBTree* mTree = nullptr;
+        };
+
+        static itask_t*& left(itask_t& n) { return n.prev; }
+        static itask_t*& right(itask_t& n) { return n.next; }
+
+        static itask_t* parent(const itask_t& n) {
+            return reinterpret_cast<itask_t*>(
+                reinterpret_cast<uintptr_t>(n.mChild) & ~uintptr_t(1)
+            );
+        }
+
+        static void setParent(itask_t& n, itask_t* p) {
+            n.mChild = reinterpret_cast<itask_t*>(
+                reinterpret_cast<uintptr_t>(p) |
+                (reinterpret_cast<uintptr_t>(n.mChild) & 1)
+            );
+        }
+
+        static bool isRed(const itask_t* n) {
+            return n && (reinterpret_cast<uintptr_t>(n->mChild) & 1);
+        }
+
+        static void setRed(itask_t& n, bool inRed) {
+            n.mChild = reinterpret_cast<itask_t*>(
+                (reinterpret_cast<uintptr_t>(n.mChild) & ~uintptr_t(1)) |
+                static_cast<uintptr_t>(inRed)
+            );
+        }
+
+        static itask_t* minimum(itask_t* n) {
+            while (left(*n)) {
+                n = left(*n);
+            }
+            return n;
+        }
+
+        static RBTree* owner(itask_t& inTask);
+
+        static void unlink(itask_t& inTask) {
+            owner(inTask)->erase(inTask);
+        }
+
+        bool less(const itask_t& a, const itask_t& b) const {
+            return static_cast<rank_t>(a.mRank - mCursor) < static_cast<rank_t>(b.mRank - mCursor);
+        }
+
+        itask_t* successor(itask_t& n);
+
+        void replace(itask_t& u, itask_t* v);
+
+        void rotateLeft(itask_t& x);
+
+        void rotateRight(itask_t& x);
+
+        void insertFixup(itask_t* z);
+
+        void erase(itask_t& z);
+
+        void eraseFixup(itask_t* x, itask_t* xParent);
+
+        HeaderTask mHeader;
+
+        itask_t* mRoot = nullptr;
+        itask_t* mLeftmost = nullptr;
+
+        std::size_t mCount = 0;
+
+        rank_t mCursor = rank_t();
+
+    };
+
+    template<typename itask_t>
+    void RBTree<itask_t>::push(itask_t& inTask) {
+
+        itask_t* p = &mHeader;
+        itask_t** link = &mRoot;
+        bool leftmost = true;
+
+        while (*link) {
+            p = *link;
+            if (less(inTask, *p)) {
+                link = &left(*p);
+            }
+            else {
+                link = &right(*p);
+                leftmost = false;
+            }
+        }
+
+        left(inTask) = nullptr;
+        right(inTask) = nullptr;
+        inTask.mChild = nullptr;
+        setParent(inTask, p);
+        setRed(inTask, true);
+        inTask.mUnlink = &RBTree::unlink;
+        *link = &inTask;
+
+        if (leftmost) {
+            mLeftmost = &inTask;
+        }
+
+        mCount++;
+        insertFixup(&inTask);
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::push(ulink::List<itask_t>& inBatch) {
+        while (!inBatch.empty()) {
+            auto& t = inBatch.front();
+            t.ulink::Node<itask_t>::remove();
+            push(t);
+        }
+    }
+
+    template<typename itask_t>
+    bool RBTree<itask_t>::sort(itask_t& inTask) {
+
+        if (inTask.mUnlink != &RBTree::unlink || owner(inTask) != this) {
+            return false;
+        }
+
+        erase(inTask);
+        push(inTask);
+        return true;
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::clear() {
+        while (mLeftmost) {
+            erase(*mLeftmost);
+        }
+    }
+
+    template<typename itask_t>
+    template<typename func_t>
+    void RBTree<itask_t>::forEach(func_t&& inFunc) {
+        for (auto* t = mLeftmost; t; t = successor(*t)) {
+            inFunc(*t);
+        }
+    }
+
+    template<typename itask_t>
+    RBTree<itask_t>* RBTree<itask_t>::owner(itask_t& inTask) {
+
+        itask_t* t = &inTask;
+
+        // the header is the only node not linked by the tree
+        while (t->mUnlink == &RBTree::unlink) {
+            t = parent(*t);
+        }
+
+        return static_cast<HeaderTask*>(t)->mTree;
+    }
+
+    template<typename itask_t>
+    itask_t* RBTree<itask_t>::successor(itask_t& n) {
+
+        if (right(n)) {
+            return minimum(right(n));
+        }
+
+        itask_t* t = &n;
+        itask_t* p = parent(*t);
+
+        while (p != &mHeader && t == right(*p)) {
+            t = p;
+            p = parent(*p);
+        }
+
+        return (p == &mHeader) ? nullptr : p;
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::replace(itask_t& u, itask_t* v) {
+
+        itask_t* p = parent(u);
+
+        if (p == &mHeader) {
+            mRoot = v;
+        }
+        else if (&u == left(*p)) {
+            left(*p) = v;
+        }
+        else {
+            right(*p) = v;
+        }
+
+        if (v) {
+            setParent(*v, p);
+        }
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::rotateLeft(itask_t& x) {
+
+        itask_t* y = right(x);
+
+        right(x) = left(*y);
+        if (left(*y)) {
+            setParent(*left(*y), &x);
+        }
+
+        replace(x, y);
+
+        left(*y) = &x;
+        setParent(x, y);
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::rotateRight(itask_t& x) {
+
+        itask_t* y = left(x);
+
+        left(x) = right(*y);
+        if (right(*y)) {
+            setParent(*right(*y), &x);
+        }
+
+        replace(x, y);
+
+        right(*y) = &x;
+        setParent(x, y);
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::insertFixup(itask_t* z) {
+
+        itask_t* p;
+
+        while ((p = parent(*z)) != &mHeader && isRed(p)) {
+
+            // a red node is never the root
+            itask_t* g = parent(*p);
+
+            if (p == left(*g)) {
+
+                itask_t* u = right(*g);
+
+                if (isRed(u)) {
+                    setRed(*p, false);
+                    setRed(*u, false);
+                    setRed(*g, true);
+                    z = g;
+                    continue;
+                }
+
+                if (z == right(*p)) {
+                    rotateLeft(*p);
+                    z = p;
+                    p = parent(*z);
+                }
+
+                setRed(*p, false);
+                setRed(*g, true);
+                rotateRight(*g);
+            }
+            else {
+
+                itask_t* u = left(*g);
+
+                if (isRed(u)) {
+                    setRed(*p, false);
+                    setRed(*u, false);
+                    setRed(*g, true);
+                    z = g;
+                    continue;
+                }
+
+                if (z == left(*p)) {
+                    rotateRight(*p);
+                    z = p;
+                    p = parent(*z);
+                }
+
+                setRed(*p, false);
+                setRed(*g, true);
+                rotateLeft(*g);
+            }
+        }
+
+        setRed(*mRoot, false);
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::erase(itask_t& z) {
+
+        if (mLeftmost == &z) {
+            mLeftmost = successor(z);
+        }
+
+        itask_t* x;
+        itask_t* xParent;
+        bool removedRed = isRed(&z);
+
+        if (!left(z)) {
+            x = right(z);
+            xParent = parent(z);
+            replace(z, x);
+        }
+        else if (!right(z)) {
+            x = left(z);
+            xParent = parent(z);
+            replace(z, x);
+        }
+        else {
+            // z is replaced by its successor y
+            itask_t* y = minimum(right(z));
+            removedRed = isRed(y);
+            x = right(*y);
+
+            if (parent(*y) == &z) {
+                xParent = y;
+            }
+            else {
+                xParent = parent(*y);
+                replace(*y, x);
+                right(*y) = right(z);
+                setParent(*right(*y), y);
+            }
+
+            replace(z, y);
+            left(*y) = left(z);
+            setParent(*left(*y), y);
+            setRed(*y, isRed(&z));
+        }
+
+        if (!removedRed) {
+            eraseFixup(x, xParent);
+        }
+
+        left(z) = nullptr;
+        right(z) = nullptr;
+        z.mChild = nullptr;
+        z.mUnlink = nullptr;
+        mCount--;
+    }
+
+    template<typename itask_t>
+    void RBTree<itask_t>::eraseFixup(itask_t* x, itask_t* xParent) {
+
+        while (x != mRoot && !isRed(x)) {
+
+            if (x == left(*xParent)) {
+
+                itask_t* w = right(*xParent);
+
+                if (isRed(w)) {
+                    setRed(*w, false);
+                    setRed(*xParent, true);
+                    rotateLeft(*xParent);
+                    w = right(*xParent);
+                }
+
+                if (!isRed(left(*w)) && !isRed(right(*w))) {
+                    setRed(*w, true);
+                    x = xParent;
+                    xParent = parent(*x);
+                    continue;
+                }
+
+                if (!isRed(right(*w))) {
+                    setRed(*left(*w), false);
+                    setRed(*w, true);
+                    rotateRight(*w);
+                    w = right(*xParent);
+                }
+
+                setRed(*w, isRed(xParent));
+                setRed(*xParent, false);
+                setRed(*right(*w), false);
+                rotateLeft(*xParent);
+            }
+            else {
+
+                itask_t* w = left(*xParent);
+
+                if (isRed(w)) {
+                    setRed(*w, false);
+                    setRed(*xParent, true);
+                    rotateRight(*xParent);
+                    w = left(*xParent);
+                }
+
+                if (!isRed(left(*w)) && !isRed(right(*w))) {
+                    setRed(*w, true);
+                    x = xParent;
+                    xParent = parent(*x);
+                    continue;
+                }
+
+                if (!isRed(left(*w))) {
+                    setRed(*right(*w), false);
+                    setRed(*w, true);
+                    rotateLeft(*w);
+                    w = left(*xParent);
+                }
+
+                setRed(*w, isRed(xParent));
+                setRed(*xParent, false);
+                setRed(*left(*w), false);
+                rotateRight(*xParent);
+            }
+
+            x = mRoot;
+        }
+
+        if (x) {
+            setRed(*x, false);
+        }
+    }
+
+}
@@ -0,0 +1,254 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include <cstddef>
+#include <limits>
+#include <string_view>
+
+namespace ucosm {
+
+    /**
+     * @brief Ready queue keeping tasks in a rank sorted intrusive list.
+     * A cursor node splits the list between tasks that have already been
+     * run in the current rank cycle and those to come, which makes the
+     * ordering wrap safe.
+     * Insertion and rescheduling are O(n), picking the next task is O(1).
+     *
+     * @tparam itask_t Task interface type.
+     */
+    template<typename itask_t>
+    struct SortedList {
+
+        using rank_t = typename itask_t::rank_t;
+
+        SortedList() {
+            mTasks.push_front(mCursorTask);
+        }
+
+        /**
+         * @brief Get the rank of the last task picked.
+         *
+         * @return rank_t Cursor rank.
+         */
+        rank_t getCursor() const { return mCursorTask.getRank(); }
+
+        /**
+         * @brief Set the rank of the last task picked.
+         *
+         * @param inRank Cursor rank.
+         */
+        void setCursor(rank_t inRank) { mCursorTask.setRank(inRank); }
+
+        /**
+         * @brief Inserts a task according to its rank.
+         *
+         * @param inTask Unlinked task.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Inserts a batch of tasks ranked at the cursor.
+         *
+         * @param inBatch List of tasks, emptied by the call.
+         */
+        void push(ulink::List<itask_t>& inBatch);
+
+        /**
+         * @brief Moves a task according to its updated rank.
+         *
+         * @param inTask Task to sort.
+         * @return true if the task was moved.
+         * @return false otherwise.
+         */
+        bool sort(itask_t& inTask);
+
+        /**
+         * @brief Returns the task with the lowest rank and moves the cursor
+         * to the list start when the end has been reached.
+         *
+         * @return itask_t* Next task or nullptr if the queue is empty.
+         */
+        itask_t* next();
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return const itask_t* Next task or nullptr if the queue is empty.
+         */
+        const itask_t* peek() const;
+
+        bool empty() const;
+
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the number of tasks that can still be pushed.
+         *
+         * @return std::size_t Free slot count.
+         */
+        std::size_t available() const { return std::numeric_limits<std::size_t>::max(); }
+
+        void clear();
+
+        /**
+         * @brief Calls a function on each node of the queue, cursor included.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void forEach(func_t&& inFunc);
+
+    private:
+
+        struct CursorTask final : itask_t {
+            void run() override {}
+            std::string_view name() override { return ">"; }
+            auto* next() { return static_cast<itask_t*>(this->itask_t::next); }
+            const auto* next() const { return static_cast<const itask_t*>(this->itask_t::next); }
+        };
+
+        ulink::List<itask_t> mTasks;
+
+        CursorTask mCursorTask;
+
+    };
+
+    template<typename itask_t>
+    void SortedList<itask_t>::push(itask_t& inTask) {
+        mTasks.insert_after(&mCursorTask, inTask);
+        this->sort(inTask);
+    }
+
+    template<typename itask_t>
+    void SortedList<itask_t>::push(ulink::List<itask_t>& inBatch) {
+
+        // the batch keeps its order right after the cursor
+        itask_t* previous = &mCursorTask;
+
+        while (!inBatch.empty()) {
+            auto& t = inBatch.front();
+            t.ulink::Node<itask_t>::remove();
+            mTasks.insert_after(previous, t);
+            previous = &t;
+        }
+    }
+
+    template<typename itask_t>
+    bool SortedList<itask_t>::sort(itask_t& inTask) {
+
+        const auto rank = inTask.getRank();
+
+        if (rank < mTasks.front().getRank()) {
+
+            mTasks.push_front(inTask);
+
+        }
+        else if (rank > mTasks.back().getRank()) {
+
+            mTasks.push_back(inTask);
+
+        }
+        else {
+            return inTask.updateRank();
+        }
+
+        return true;
+
+    }
+
+    template<typename itask_t>
+    itask_t* SortedList<itask_t>::next() {
+
+        auto& front = mTasks.front();
+        auto& back = mTasks.back();
+
+        if (&front == &back) {
+            // only the cursor task is in the list
+            return nullptr;
+        }
+
+        if (&mCursorTask == &back) {
+            // cursor is last
+            // update cursor
+            mTasks.push_front(mCursorTask);
+            return &front;
+        }
+        else {
+            return mCursorTask.next();
+        }
+
+    }
+
+    template<typename itask_t>
+    const itask_t* SortedList<itask_t>::peek() const {
+
+        auto& front = mTasks.front();
+        auto& back = mTasks.back();
+
+        if (&front == &back) {
+            // only the cursor task is in the list
+            return nullptr;
+        }
+
+        if (&mCursorTask == &back) {
+            return &front;
+        }
+        else {
+            return mCursorTask.next();
+        }
+
+    }
+
+    template<typename itask_t>
+    bool SortedList<itask_t>::empty() const {
+        return (&mTasks.front() == &mTasks.back());
+    }
+
+    template<typename itask_t>
+    std::size_t SortedList<itask_t>::size() const {
+        return (mTasks.size() - 1);
+    }
+
+    template<typename itask_t>
+    void SortedList<itask_t>::clear() {
+        mTasks.clear();
+        mTasks.push_front(mCursorTask);
+    }
+
+    template<typename itask_t>
+    template<typename func_t>
+    void SortedList<itask_t>::forEach(func_t&& inFunc) {
+        for (auto& t : mTasks) {
+            inFunc(t);
+        }
+    }
+
+}
@@ -0,0 +1,126 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+
+namespace ucosm {
+
+    /**
+     * @brief Intrusive multi-producer single-consumer task inbox.
+     *
+     * Tasks are chained through their spare link, which is free while a
+     * task is not held by a ready queue. Producers push with a single
+     * compare-and-swap on the head, the consumer takes the whole chain
+     * at once and restores the push order.
+     *
+     * @tparam itask_t Task type.
+     */
+    template<typename itask_t>
+    struct TaskInbox {
+
+        /**
+         * @brief Pushes a task into the inbox.
+         * Can be called from any thread. The task must not be linked
+         * nor already pushed.
+         *
+         * @param inTask Task instance.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Removes every task from the inbox in push order.
+         * Must only be called by the consumer thread.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void drain(func_t&& inFunc);
+
+        bool empty() const;
+
+    private:
+
+        std::atomic<itask_t*> mHead { nullptr };
+
+    };
+
+    template<typename itask_t>
+    void TaskInbox<itask_t>::push(itask_t& inTask) {
+
+        auto* head = mHead.load(std::memory_order_relaxed);
+
+        do {
+            inTask.mChild = head;
+        } while (
+            !mHead.compare_exchange_weak(
+                head,
+                &inTask,
+                std::memory_order_release,
+                std::memory_order_relaxed
+            )
+        );
+
+    }
+
+    template<typename itask_t>
+    template<typename func_t>
+    void TaskInbox<itask_t>::drain(func_t&& inFunc) {
+
+        if (!mHead.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        auto* t = mHead.exchange(nullptr, std::memory_order_acquire);
+
+        // the chain is in reverse push order
+        itask_t* reversed = nullptr;
+
+        while (t) {
+            auto* next = t->mChild;
+            t->mChild = reversed;
+            reversed = t;
+            t = next;
+        }
+
+        while (reversed) {
+            auto* next = reversed->mChild;
+            reversed->mChild = nullptr;
+            inFunc(*reversed);
+            reversed = next;
+        }
+
+    }
+
+    template<typename itask_t>
+    bool TaskInbox<itask_t>::empty() const {
+        return !mHead.load(std::memory_order_acquire);
+    }
+
+}
@@ -0,0 +1,217 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <new>
+#include <utility>
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Fixed capacity pool of tasks.
+     *
+     * Tasks are constructed in place in the pool storage and added to a
+     * scheduler by spawn(). A slot goes back to the pool when its task is
+     * removed (deinit() is overridden by the pool), or when the scheduler
+     * refuses it. Free slots are chained in an intrusive FIFO list, so
+     * allocation and release are O(1), and a released slot is reused as
+     * late as possible. The task object is destroyed when its slot is
+     * reused or when the pool is destroyed, as removeTask() still accesses
+     * it after deinit(). A task removed during its own run() gives its
+     * slot back once the run returns, so it may spawn other tasks from
+     * there without its slot being reused under it.
+     *
+     * @tparam task_t Task type, must not be final and its run() must be accessible.
+     * @tparam capacity Number of slots.
+     */
+    template<typename task_t, std::size_t capacity>
+    struct TaskPool {
+
+        static_assert(capacity > 0, "pool capacity must be greater than zero");
+
+        TaskPool();
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator=(const TaskPool&) = delete;
+
+        ~TaskPool();
+
+        /**
+         * @brief Constructs a task in a free slot and adds it to a scheduler.
+         *
+         * @param inScheduler Scheduler the task is added to.
+         * @param inArgs Arguments forwarded to the task constructor.
+         * @return task_t* Pointer to the task,
+         * nullptr if the pool is full or the task wasn't added.
+         */
+        template<typename scheduler_t, typename ... args_t>
+        task_t* spawn(scheduler_t& inScheduler, args_t&&... inArgs);
+
+        /**
+         * @brief Returns the number of free slots.
+         *
+         * @return std::size_t Number of free slots.
+         */
+        std::size_t available() const { return mFreeCount; }
+
+    private:
+
+        struct Slot final : task_t {
+
+            template<typename ... args_t>
+            Slot(TaskPool& inPool, args_t&&... inArgs) :
+                task_t(std::forward<args_t>(inArgs)...),
+                mPool(inPool) {}
+
+            void run() override {
+                Cell& cell = cellOf(*this);
+                cell.mRunning = true;
+                task_t::run();
+                cell.mRunning = false;
+                if (cell.mReleased) {
+                    // removed during the run
+                    cell.mReleased = false;
+                    mPool.release(cell);
+                }
+            }
+
+            void deinit() override {
+                task_t::deinit();
+                Cell& cell = cellOf(*this);
+                if (cell.mRunning) {
+                    // the run is still on the stack, released when it returns
+                    cell.mReleased = true;
+                }
+                else {
+                    mPool.release(cell);
+                }
+            }
+
+            TaskPool& mPool;
+        };
+
+        struct Cell {
+            alignas(Slot) std::byte mData[sizeof(Slot)];
+            Cell* mNextFree = nullptr;
+            bool mConstructed = false;
+            bool mRunning = false;
+            bool mReleased = false;
+        };
+
+        static Cell& cellOf(Slot& inSlot) {
+            // the storage is the first member of the cell
+            return *reinterpret_cast<Cell*>(reinterpret_cast<std::byte*>(&inSlot));
+        }
+
+        static Slot& slotOf(Cell& inCell) {
+            return *std::launder(reinterpret_cast<Slot*>(inCell.mData));
+        }
+
+        void release(Cell& inCell);
+
+        Cell mCells[capacity];
+
+        Cell* mFirstFree = nullptr;
+        Cell* mLastFree = nullptr;
+
+        std::size_t mFreeCount = capacity;
+
+    };
+
+    template<typename task_t, std::size_t capacity>
+    TaskPool<task_t, capacity>::TaskPool() {
+        for (std::size_t i = 0; i + 1 < capacity; i++) {
+            mCells[i].mNextFree = &mCells[i + 1];
+        }
+        mFirstFree = &mCells[0];
+        mLastFree = &mCells[capacity - 1];
+    }
+
+    template<typename task_t, std::size_t capacity>
+    TaskPool<task_t, capacity>::~TaskPool() {
+        for (auto& cell : mCells) {
+            if (cell.mConstructed) {
+                // a task still held by a scheduler is unlinked
+                // by its destructor, without deinit
+                slotOf(cell).~Slot();
+            }
+        }
+    }
+
+    template<typename task_t, std::size_t capacity>
+    template<typename scheduler_t, typename ... args_t>
+    task_t* TaskPool<task_t, capacity>::spawn(scheduler_t& inScheduler, args_t&&... inArgs) {
+
+        if (!mFirstFree) {
+            // pool is full
+            return nullptr;
+        }
+
+        Cell& cell = *mFirstFree;
+
+        mFirstFree = cell.mNextFree;
+        if (!mFirstFree) {
+            mLastFree = nullptr;
+        }
+        cell.mNextFree = nullptr;
+        mFreeCount--;
+
+        if (cell.mConstructed) {
+            // task released since the slot was freed
+            slotOf(cell).~Slot();
+        }
+
+        auto* slot = ::new(cell.mData) Slot(*this, std::forward<args_t>(inArgs)...);
+        cell.mConstructed = true;
+
+        if (!inScheduler.addTask(*slot)) {
+            // init failed or scheduler refused the task
+            release(cell);
+            return nullptr;
+        }
+
+        return slot;
+    }
+
+    template<typename task_t, std::size_t capacity>
+    void TaskPool<task_t, capacity>::release(Cell& inCell) {
+
+        // slots are reused in release order
+        if (mLastFree) {
+            mLastFree->mNextFree = &inCell;
+        }
+        else {
+            mFirstFree = &inCell;
+        }
+
+        mLastFree = &inCell;
+        mFreeCount++;
+    }
+
+}
@@ -0,0 +1,186 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Execution statistics of a task.
+     * Durations are in scheduler ticks. Lateness is the tick at which the
+     * run started minus the tick at which the task was due, it is 0 for
+     * schedulers whose ranks aren't times (CFS).
+     */
+    struct TaskStats {
+
+        using tick_t = uint32_t;
+
+        uint32_t runCount = 0;
+        tick_t lastTicks = 0;
+        tick_t maxTicks = 0;
+        uint64_t totalTicks = 0;
+        tick_t lastLateness = 0;
+        tick_t maxLateness = 0;
+
+        void record(tick_t inTicks, tick_t inLateness) {
+            runCount++;
+            lastTicks = inTicks;
+            totalTicks += inTicks;
+            lastLateness = inLateness;
+            if (inTicks > maxTicks) {
+                maxTicks = inTicks;
+            }
+            if (inLateness > maxLateness) {
+                maxLateness = inLateness;
+            }
+        }
+    };
+
+    /**
+     * @brief Statistics policy that doesn't record anything.
+     * Empty, the measurement code of the run loops is compiled out.
+     */
+    struct NoStats {
+
+        static constexpr bool enabled = false;
+
+    };
+
+    /**
+     * @brief Statistics policy recording up to capacity tasks.
+     *
+     * Records are looked up by task address with a linear search. The
+     * scheduler forgets the record of a task when it is added, removed
+     * from its run or cleared, so a new task at the same address starts
+     * afresh. Runs of tasks that don't fit in the table are only counted
+     * by dropped().
+     *
+     * @tparam capacity Maximum number of recorded tasks.
+     */
+    template<std::size_t capacity>
+    struct StatsTable {
+
+        static_assert(capacity > 0, "null capacity");
+
+        static constexpr bool enabled = true;
+
+        /**
+         * @brief Returns the record of a task, created on first use.
+         *
+         * @param inTask Task address.
+         * @return TaskStats* Task record, nullptr if the table is full.
+         */
+        TaskStats* recordOf(const void* inTask);
+
+        /**
+         * @brief Returns the record of a task.
+         *
+         * @param inTask Task address.
+         * @return const TaskStats* Task record, nullptr if the task was never recorded.
+         */
+        const TaskStats* findRecord(const void* inTask) const;
+
+        /**
+         * @brief Removes the record of a task, if any.
+         *
+         * @param inTask Task address.
+         */
+        void forget(const void* inTask);
+
+        /**
+         * @brief Removes every record.
+         */
+        void reset();
+
+        /**
+         * @brief Returns the number of runs that couldn't be recorded.
+         *
+         * @return uint32_t Number of runs.
+         */
+        uint32_t dropped() const { return mDropped; }
+
+    private:
+
+        const void* mTasks[capacity] = {};
+        TaskStats mStats[capacity];
+        std::size_t mSize = 0;
+        uint32_t mDropped = 0;
+
+    };
+
+    template<std::size_t capacity>
+    TaskStats* StatsTable<capacity>::recordOf(const void* inTask) {
+
+        for (std::size_t i = 0; i < mSize; i++) {
+            if (mTasks[i] == inTask) {
+                return &mStats[i];
+            }
+        }
+
+        if (mSize == capacity) {
+            mDropped++;
+            return nullptr;
+        }
+
+        mTasks[mSize] = inTask;
+        mStats[mSize] = TaskStats();
+        return &mStats[mSize++];
+    }
+
+    template<std::size_t capacity>
+    const TaskStats* StatsTable<capacity>::findRecord(const void* inTask) const {
+        for (std::size_t i = 0; i < mSize; i++) {
+            if (mTasks[i] == inTask) {
+                return &mStats[i];
+            }
+        }
+        return nullptr;
+    }
+
+    template<std::size_t capacity>
+    void StatsTable<capacity>::forget(const void* inTask) {
+        for (std::size_t i = 0; i < mSize; i++) {
+            if (mTasks[i] == inTask) {
+                // the last record takes its place
+                mSize--;
+                mTasks[i] = mTasks[mSize];
+                mStats[i] = mStats[mSize];
+                return;
+            }
+        }
+    }
+
+    template<std::size_t capacity>
+    void StatsTable<capacity>::reset() {
+        mSize = 0;
+        mDropped = 0;
+    }
+
+}
@@ -0,0 +1,94 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "iwakeup.hpp"
+#include <atomic>
+
+namespace ucosm {
+
+    /**
+     * @brief Parks a task until an event source notifies it.
+     *
+     * The task parks itself from its run() function and leaves the ready
+     * queue, it isn't run again until notify() is called, typically by
+     * the producer of an RTMessageQueue or RTEventFlags the waiter is
+     * attached to. notify() resumes the task only if it is parked, so
+     * producers can call it on every event.
+     *
+     * The task must check its wait condition again after park(): an event
+     * produced in-between has either seen the task parked and resumed it,
+     * or is visible to the check, in which case cancel() resumes the task.
+     *
+     * @tparam scheduler_t Scheduler type holding the task.
+     * @tparam task_t Task type of the scheduler.
+     */
+    template<typename scheduler_t, typename task_t>
+    struct TaskWaiter : IWakeup {
+
+        TaskWaiter(scheduler_t& inScheduler, task_t& inTask) :
+            mScheduler(inScheduler),
+            mTask(inTask) {}
+
+        /**
+         * @brief Takes the task out of the ready queue.
+         * Must be called from the scheduler thread, usually from the task itself.
+         */
+        void park() {
+            mScheduler.park(mTask);
+            mParked.exchange(true, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Resumes the task if it is still parked.
+         * Used when the wait condition became true right after park().
+         */
+        void cancel() { notify(); }
+
+        /**
+         * @brief Resumes the task if it is parked.
+         * Can be called from any thread.
+         */
+        void notify() override {
+            // the exchange orders the event before the parked state is read
+            if (mParked.exchange(false, std::memory_order_acq_rel)) {
+                mScheduler.resume(mTask);
+            }
+        }
+
+        bool isParked() const { return mParked.load(std::memory_order_acquire); }
+
+    private:
+
+        scheduler_t& mScheduler;
+        task_t& mTask;
+        std::atomic<bool> mParked { false };
+
+    };
+
+}
@@ -0,0 +1,380 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include "bits.hpp"
+#include <stdint.h>
+#include <cstddef>
+#include <limits>
+
+namespace ucosm {
+
+    /**
+     * @brief Ready queue keeping tasks in a hierarchical timing wheel.
+     *
+     * Ranks are extended to 64 bits relatively to the cursor. A task is
+     * stored in the level of the highest 6 bits digit where its rank
+     * differs from the cursor, in the slot given by this digit. Tasks too
+     * far from the cursor for the last level wait in an overflow list.
+     * When the cursor moves, the only bucket that needs to be spread on
+     * the lower levels is the one the cursor enters.
+     *
+     * Insertion is O(1), picking the next task is O(1) when it is due in
+     * the current 64 ranks window. Buckets are ulink lists so no memory is
+     * allocated, but the wheel itself holds 4 x 64 lists.
+     *
+     * @tparam itask_t Task interface type.
+     */
+    template<typename itask_t>
+    struct TimingWheel {
+
+        using rank_t = typename itask_t::rank_t;
+
+        static constexpr uint8_t slot_bits = 6;
+        static constexpr uint8_t slot_count = 1 << slot_bits;
+        static constexpr uint8_t level_count = 4;
+
+        TimingWheel() { mAnchor.mWheel = this; }
+        TimingWheel(const TimingWheel&) = delete;
+        TimingWheel& operator=(const TimingWheel&) = delete;
+
+        ~TimingWheel() { clear(); }
+
+        /**
+         * @brief Get the rank of the last task picked.
+         *
+         * @return rank_t Cursor rank.
+         */
+        rank_t getCursor() const { return static_cast<rank_t>(mBase); }
+
+        /**
+         * @brief Set the rank of the last task picked and cascades the
+         * bucket it enters. The new cursor must not rank after any task.
+         *
+         * @param inRank Cursor rank.
+         */
+        void setCursor(rank_t inRank);
+
+        /**
+         * @brief Inserts a task according to its rank.
+         *
+         * @param inTask Unlinked task.
+         */
+        void push(itask_t& inTask);
+
+        /**
+         * @brief Inserts a batch of tasks ranked at the cursor.
+         *
+         * @param inBatch List of tasks, emptied by the call.
+         */
+        void push(ulink::List<itask_t>& inBatch);
+
+        /**
+         * @brief Moves a task according to its updated rank.
+         *
+         * @param inTask Task to sort.
+         * @return true if the task was moved.
+         * @return false if the task isn't in the wheel.
+         */
+        bool sort(itask_t& inTask);
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return itask_t* Next task or nullptr if the queue is empty.
+         */
+        itask_t* next();
+
+        /**
+         * @brief Returns the task with the lowest rank.
+         *
+         * @return const itask_t* Next task or nullptr if the queue is empty.
+         */
+        const itask_t* peek() const {
+            return const_cast<TimingWheel*>(this)->next();
+        }
+
+        bool empty() const { return mCount == 0; }
+
+        std::size_t size() const { return mCount; }
+
+        /**
+         * @brief Returns the number of tasks that can still be pushed.
+         *
+         * @return std::size_t Free slot count.
+         */
+        std::size_t available() const { return std::numeric_limits<std::size_t>::max(); }
+
+        void clear();
+
+        /**
+         * @brief Calls a function on each task of the queue.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking an itask_t reference.
+         */
+        template<typename func_t>
+        void forEach(func_t&& inFunc);
+
+    private:
+
+        using bucket_t = ulink::List<itask_t>;
+
+        // tasks of the wheel point to it through their child link
+        struct AnchorTask final : itask_t {
+            void run() override {}
+            TimingWheel* mWheel = nullptr;
+        };
+
+        static uint8_t digit(uint64_t inRank, uint8_t inLevel) {
+            return (inRank >> (inLevel * slot_bits)) & (slot_count - 1);
+        }
+
+        rank_t delta(const itask_t& inTask) const {
+            return static_cast<rank_t>(inTask.mRank - static_cast<rank_t>(mBase));
+        }
+
+        void place(itask_t& inTask);
+
+        void spread(bucket_t& inBucket);
+
+        itask_t* lowest(bucket_t& inBucket) const;
+
+        static void unlink(itask_t& inTask);
+
+        bucket_t mBuckets[level_count][slot_count];
+        bucket_t mOverflow;
+
+        // a set bit might refer to a bucket that has been emptied since
+        uint64_t mOccupied[level_count] = {};
+
+        uint64_t mBase = 0;
+        std::size_t mCount = 0;
+        itask_t* mNext = nullptr;
+
+        AnchorTask mAnchor;
+
+    };
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::setCursor(rank_t inRank) {
+
+        const uint64_t base = mBase + static_cast<rank_t>(inRank - static_cast<rank_t>(mBase));
+        const uint64_t diff = base ^ mBase;
+
+        if (!diff) {
+            return;
+        }
+
+        mBase = base;
+
+        // every lower level is empty since no task ranks before the cursor
+        const uint8_t level = bits::msb(diff) / slot_bits;
+
+        if (level < level_count) {
+            const uint8_t slot = digit(base, level);
+            mOccupied[level] &= ~(uint64_t(1) << slot);
+            spread(mBuckets[level][slot]);
+        }
+        else {
+            spread(mOverflow);
+        }
+    }
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::push(itask_t& inTask) {
+
+        inTask.mChild = &mAnchor;
+        inTask.mUnlink = &TimingWheel::unlink;
+
+        place(inTask);
+        mCount++;
+
+        if (mNext && delta(inTask) < delta(*mNext)) {
+            mNext = &inTask;
+        }
+    }
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::push(ulink::List<itask_t>& inBatch) {
+        while (!inBatch.empty()) {
+            auto& t = inBatch.front();
+            t.ulink::Node<itask_t>::remove();
+            push(t);
+        }
+    }
+
+    template<typename itask_t>
+    bool TimingWheel<itask_t>::sort(itask_t& inTask) {
+
+        if (inTask.mChild != &mAnchor) {
+            return false;
+        }
+
+        unlink(inTask);
+        push(inTask);
+        return true;
+    }
+
+    template<typename itask_t>
+    itask_t* TimingWheel<itask_t>::next() {
+
+        if (mNext || !mCount) {
+            return mNext;
+        }
+
+        for (uint8_t level = 0; level < level_count; level++) {
+
+            uint64_t occupied = mOccupied[level] & (~uint64_t(0) << digit(mBase, level));
+
+            while (occupied) {
+
+                const uint8_t slot = bits::lsb(occupied);
+                auto& bucket = mBuckets[level][slot];
+
+                if (!bucket.empty()) {
+                    // level 0 buckets only hold tasks of the same rank
+                    mNext = level ? lowest(bucket) : &bucket.front();
+                    return mNext;
+                }
+
+                mOccupied[level] &= ~(uint64_t(1) << slot);
+                occupied &= occupied - 1;
+            }
+        }
+
+        mNext = lowest(mOverflow);
+        return mNext;
+    }
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::clear() {
+
+        // bucket by bucket, next() would scan the upper level buckets
+        for (auto& level : mBuckets) {
+            for (auto& bucket : level) {
+                while (!bucket.empty()) {
+                    unlink(bucket.front());
+                }
+            }
+        }
+
+        while (!mOverflow.empty()) {
+            unlink(mOverflow.front());
+        }
+
+        for (auto& o : mOccupied) {
+            o = 0;
+        }
+    }
+
+    template<typename itask_t>
+    template<typename func_t>
+    void TimingWheel<itask_t>::forEach(func_t&& inFunc) {
+
+        for (auto& level : mBuckets) {
+            for (auto& bucket : level) {
+                for (auto& t : bucket) {
+                    inFunc(t);
+                }
+            }
+        }
+
+        for (auto& t : mOverflow) {
+            inFunc(t);
+        }
+    }
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::place(itask_t& inTask) {
+
+        const uint64_t rank = mBase + delta(inTask);
+        const uint64_t diff = rank ^ mBase;
+        const uint8_t level = diff ? bits::msb(diff) / slot_bits : 0;
+
+        if (level < level_count) {
+            const uint8_t slot = digit(rank, level);
+            mBuckets[level][slot].push_back(inTask);
+            mOccupied[level] |= uint64_t(1) << slot;
+        }
+        else {
+            mOverflow.push_back(inTask);
+        }
+    }
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::spread(bucket_t& inBucket) {
+
+        // the tasks might go back to the same list
+        bucket_t moved;
+
+        while (!inBucket.empty()) {
+            auto& t = inBucket.front();
+            t.ulink::Node<itask_t>::remove();
+            moved.push_back(t);
+        }
+
+        while (!moved.empty()) {
+            auto& t = moved.front();
+            t.ulink::Node<itask_t>::remove();
+            place(t);
+        }
+    }
+
+    template<typename itask_t>
+    itask_t* TimingWheel<itask_t>::lowest(bucket_t& inBucket) const {
+
+        itask_t* low = nullptr;
+
+        for (auto& t : inBucket) {
+            if (!low || delta(t) < delta(*low)) {
+                low = &t;
+            }
+        }
+
+        return low;
+    }
+
+    template<typename itask_t>
+    void TimingWheel<itask_t>::unlink(itask_t& inTask) {
+
+        auto* wheel = static_cast<AnchorTask*>(inTask.mChild)->mWheel;
+
+        inTask.ulink::Node<itask_t>::remove();
+        inTask.mChild = nullptr;
+        inTask.mUnlink = nullptr;
+
+        wheel->mCount--;
+
+        if (wheel->mNext == &inTask) {
+            wheel->mNext = nullptr;
+        }
+    }
+
+}
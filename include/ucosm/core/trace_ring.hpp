@@ -0,0 +1,198 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <string_view>
+#include <stdint.h>
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Scheduling event kinds.
+     */
+    enum class TraceEvent : uint8_t {
+        TaskAdd,
+        TaskRemove,
+        TaskStart,
+        TaskStop,
+        Idle,
+        TimerSet,
+        TimerStop,
+        DeadlineMiss,
+        TaskPark,
+        TaskResume
+    };
+
+    /**
+     * @brief Scheduling event.
+     */
+    struct TraceRecord {
+        std::string_view name;
+        uint32_t tick = 0;
+        uint32_t value = 0;
+        TraceEvent event = TraceEvent::Idle;
+    };
+
+    /**
+     * @brief Single writer ring of scheduling events.
+     *
+     * The writer overwrites the oldest records once the ring is full and
+     * never blocks. forEach() may run on another thread: records that the
+     * writer could have overwritten while they were copied are skipped.
+     * Task names are stored as views, they must outlive the export.
+     */
+    struct TraceRing {
+
+        using get_tick_t = uint32_t(*)();
+
+        /**
+         * @brief Construct a new trace ring over a given storage.
+         *
+         * @param inRecords Record storage.
+         * @param inCapacity Number of records, a power of 2.
+         * @param inGetTick Clock used to timestamp the records.
+         */
+        TraceRing(TraceRecord* inRecords, std::size_t inCapacity, get_tick_t inGetTick) :
+            mRecords(inRecords),
+            mMask(static_cast<uint32_t>(inCapacity - 1)),
+            mGetTick(inGetTick) {}
+
+        TraceRing(const TraceRing&) = delete;
+        TraceRing& operator=(const TraceRing&) = delete;
+
+        /**
+         * @brief Appends an event, writer side.
+         *
+         * @param inEvent Event kind.
+         * @param inName Task name, empty for scheduler events.
+         * @param inValue Event value (timer duration).
+         */
+        void record(TraceEvent inEvent, std::string_view inName = {}, uint32_t inValue = 0);
+
+        /**
+         * @brief Calls a function with each available record, oldest first.
+         *
+         * @tparam func_t Function type.
+         * @param inFunc Function taking a const TraceRecord reference.
+         * @return std::size_t Number of records passed to the function.
+         */
+        template<typename func_t>
+        std::size_t forEach(func_t&& inFunc) const;
+
+        /**
+         * @brief Returns the number of records written since the creation
+         * of the ring, overwritten ones included.
+         *
+         * @return uint32_t Number of records.
+         */
+        uint32_t written() const { return mHead.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Returns the number of records the ring can hold.
+         *
+         * @return std::size_t Number of records.
+         */
+        std::size_t capacity() const { return std::size_t(mMask) + 1; }
+
+    private:
+
+        TraceRecord* mRecords;
+        uint32_t mMask;
+        get_tick_t mGetTick;
+        std::atomic<uint32_t> mHead { 0 };
+        std::atomic<uint32_t> mReserved { 0 };
+
+    };
+
+    /**
+     * @brief Trace ring with its own storage.
+     *
+     * @tparam record_count Number of records, a power of 2.
+     */
+    template<std::size_t record_count>
+    struct TraceBuffer : TraceRing {
+
+        static_assert(record_count && !(record_count & (record_count - 1)), "capacity must be a power of 2");
+
+        TraceBuffer(get_tick_t inGetTick) :
+            TraceRing(mStorage, record_count, inGetTick) {}
+
+    private:
+
+        TraceRecord mStorage[record_count];
+
+    };
+
+    inline void TraceRing::record(TraceEvent inEvent, std::string_view inName, uint32_t inValue) {
+
+        const auto head = mHead.load(std::memory_order_relaxed);
+
+        // tell the readers that the oldest slot is being overwritten
+        mReserved.store(head + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& r = mRecords[head & mMask];
+        r.name = inName;
+        r.tick = mGetTick();
+        r.value = inValue;
+        r.event = inEvent;
+
+        // publish the record
+        mHead.store(head + 1, std::memory_order_release);
+    }
+
+    template<typename func_t>
+    std::size_t TraceRing::forEach(func_t&& inFunc) const {
+
+        const uint32_t head = mHead.load(std::memory_order_acquire);
+        const uint32_t size = mMask + 1;
+
+        uint32_t i = (head > size) ? head - size : 0;
+
+        std::size_t count = 0;
+
+        for (; i != head; i++) {
+
+            const TraceRecord r = mRecords[i & mMask];
+
+            // record i is overwritten by the record i + size
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (mReserved.load(std::memory_order_relaxed) - i > size) {
+                continue;
+            }
+
+            inFunc(r);
+            count++;
+        }
+
+        return count;
+    }
+
+}
@@ -0,0 +1,169 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Lock-free work-stealing deque of pointers (Chase-Lev).
+     *
+     * The owner thread pushes and pops at the bottom, any other thread
+     * steals at the top. Each pushed item is returned exactly once, either
+     * by pop() or by steal(). The capacity is fixed, push() fails when the
+     * deque is full.
+     *
+     * @tparam item_t Pointed type.
+     * @tparam capacity Maximum number of items, must be a power of two.
+     */
+    template<typename item_t, std::size_t capacity>
+    struct WorkStealingDeque {
+
+        static_assert(capacity && !(capacity & (capacity - 1)), "capacity must be a power of two");
+
+        /**
+         * @brief Pushes an item at the bottom. Owner thread only.
+         *
+         * @param inItem Item pointer, not null.
+         * @return true if the item was pushed.
+         * @return false if the deque is full.
+         */
+        bool push(item_t* inItem);
+
+        /**
+         * @brief Takes the last pushed item. Owner thread only.
+         *
+         * @return item_t* Item or nullptr if the deque is empty.
+         */
+        item_t* pop();
+
+        /**
+         * @brief Takes the first pushed item. Can be called from any thread.
+         *
+         * @return item_t* Item or nullptr if the deque is empty or if
+         * another thread took the item first.
+         */
+        item_t* steal();
+
+        /**
+         * @brief Returns the number of items, only exact for the owner.
+         *
+         * @return std::size_t Item count.
+         */
+        std::size_t size() const;
+
+        bool empty() const { return size() == 0; }
+
+    private:
+
+        using index_t = int64_t;
+
+        static constexpr index_t kMask = static_cast<index_t>(capacity - 1);
+
+        std::atomic<index_t> mTop { 0 };
+        std::atomic<index_t> mBottom { 0 };
+        std::atomic<item_t*> mItems[capacity] {};
+
+    };
+
+    template<typename item_t, std::size_t capacity>
+    bool WorkStealingDeque<item_t, capacity>::push(item_t* inItem) {
+
+        const auto b = mBottom.load(std::memory_order_relaxed);
+        const auto t = mTop.load(std::memory_order_acquire);
+
+        if (b - t >= static_cast<index_t>(capacity)) {
+            return false;
+        }
+
+        mItems[b & kMask].store(inItem, std::memory_order_relaxed);
+
+        // publishes the item to the thieves
+        mBottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename item_t, std::size_t capacity>
+    item_t* WorkStealingDeque<item_t, capacity>::pop() {
+
+        const auto b = mBottom.load(std::memory_order_relaxed) - 1;
+
+        // reserving the bottom item must be ordered before reading the top
+        mBottom.store(b, std::memory_order_seq_cst);
+        auto t = mTop.load(std::memory_order_seq_cst);
+
+        if (t > b) {
+            // empty
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* item = mItems[b & kMask].load(std::memory_order_relaxed);
+
+        if (t == b) {
+            // last item, race against the thieves
+            if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            mBottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    template<typename item_t, std::size_t capacity>
+    item_t* WorkStealingDeque<item_t, capacity>::steal() {
+
+        auto t = mTop.load(std::memory_order_seq_cst);
+        const auto b = mBottom.load(std::memory_order_seq_cst);
+
+        if (t >= b) {
+            return nullptr;
+        }
+
+        auto* item = mItems[t & kMask].load(std::memory_order_relaxed);
+
+        if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            // taken by the owner or by another thief
+            return nullptr;
+        }
+
+        return item;
+    }
+
+    template<typename item_t, std::size_t capacity>
+    std::size_t WorkStealingDeque<item_t, capacity>::size() const {
+        const auto b = mBottom.load(std::memory_order_relaxed);
+        const auto t = mTop.load(std::memory_order_relaxed);
+        return (b > t) ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+}
@@ -0,0 +1,300 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/ischeduler.hpp"
+#include "iedf_task.hpp"
+#include <cstddef>
+#include <stdint.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Earliest deadline first scheduler.
+     * Jobs wait for their release in the ready queue, ordered by release
+     * tick. Released jobs move to a list ordered by absolute deadline and
+     * the one with the earliest deadline runs. Once it completes, the task
+     * goes back to the queue, released one period after its previous release.
+     * forEachStats() only visits the tasks waiting for their release,
+     * use statsOf() for the others.
+     *
+     * @tparam sched_task_t Scheduler task type
+     * @tparam queue_t Release queue type (SortedList, PairingHeap, TimingWheel, RBTree,
+     * FixedRankTable<N>::type)
+     * @tparam stats_t Statistics policy (NoStats, StatsTable<N>), the lateness
+     * is measured from the release tick.
+     */
+    template<
+        typename sched_task_t = ITask<int8_t>,
+        template<typename> typename queue_t = SortedList,
+        typename stats_t = NoStats
+    >
+    struct EDFScheduler : IScheduler<IEDFTask, sched_task_t, queue_t, stats_t> {
+
+        using get_tick_t = IEDFTask::tick_t(*)();
+
+        EDFScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
+            IScheduler<IEDFTask, sched_task_t, queue_t, stats_t>(inIdleTask),
+            mGetTick(inGetTick) {}
+
+        /**
+         * @brief Adds a task, its first job is released after the task offset.
+         *
+         * @param inTask Task instance, with a non null period.
+         * @return true if the task was successfully added.
+         * @return false otherwise.
+         */
+        bool addTask(IEDFTask& inTask) override;
+
+        template<typename iterator_t, typename mask_iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast, mask_iterator_t outMask) {
+            // each task goes through the period check and gets its offset
+            std::size_t count = 0;
+            for (; inFirst != inLast; ++inFirst, ++outMask) {
+                const bool added = this->addTask(toTask(*inFirst));
+                *outMask = added;
+                count += added;
+            }
+            return count;
+        }
+
+        template<typename iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast) {
+            std::size_t count = 0;
+            for (; inFirst != inLast; ++inFirst) {
+                count += this->addTask(toTask(*inFirst));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Releases the due jobs and runs the one with the earliest deadline.
+         */
+        void run() override;
+
+        /**
+         * @brief Returns the number of tasks, released or not.
+         *
+         * @return std::size_t Number of tasks.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Tells if the scheduler contains any task.
+         *
+         * @return true if the scheduler doesn't contain any task.
+         * @return false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Removes every tasks from the scheduler.
+         */
+        void clear();
+
+        /**
+         * @brief Pushes task names into a given stream, released tasks first.
+         *
+         * @tparam stream_t Stream type.
+         * @param inStream Stream instance.
+         * @param inSep Character used to separate task names.
+         */
+        template<typename stream_t>
+        void list(stream_t&& inStream, std::string_view inSeparator = "\n");
+
+        // released jobs don't go through the queue
+        void park(IEDFTask& inTask) = delete;
+        void resume(IEDFTask& inTask) = delete;
+
+    private:
+
+        using base_t = IScheduler<IEDFTask, sched_task_t, queue_t, stats_t>;
+        using itask_t = typename base_t::itask_t;
+
+        /**
+         * @brief Moves the jobs released at the given tick to the ready list.
+         *
+         * @param inTick Current tick.
+         */
+        void release(IEDFTask::tick_t inTick);
+
+        static IEDFTask& toTask(IEDFTask& inTask) { return inTask; }
+        static IEDFTask& toTask(IEDFTask* inTask) { return *inTask; }
+
+        get_tick_t mGetTick;
+
+        // released jobs, ordered by absolute deadline
+        ulink::List<itask_t> mReady;
+
+    };
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    bool EDFScheduler<sched_task_t, queue_t, stats_t>::addTask(IEDFTask& inTask) {
+
+        if (inTask.getPeriod() == 0 || this->mTasks.available() <= mReady.size()) {
+            // invalid period, or no room left in the queue
+            // for the released jobs to come back
+            return false;
+        }
+
+        if (!base_t::addTask(inTask)) {
+            return false;
+        }
+
+        // the release queue cursor is never ahead of the clock
+        inTask.setRank(mGetTick() + inTask.getOffset());
+        this->sortTask(inTask);
+        return true;
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void EDFScheduler<sched_task_t, queue_t, stats_t>::release(IEDFTask::tick_t inTick) {
+
+        while (auto* task = this->getNextTask()) {
+
+            const auto cursorRank = this->mTasks.getCursor();
+            const auto deltaTask = task->getRank() - cursorRank;
+            const auto deltaTick = inTick - cursorRank;
+
+            if (deltaTick < deltaTask) {
+                // not released yet
+                break;
+            }
+
+            this->mTasks.setCursor(task->getRank());
+            this->detach(*task);
+
+            // wrap safe, deadlines are compared relatively to the tick
+            const auto deadline = static_cast<int32_t>(task->getAbsoluteDeadline() - inTick);
+            itask_t* previous = nullptr;
+
+            for (auto& t : mReady) {
+                if (deadline < static_cast<int32_t>(static_cast<IEDFTask&>(t).getAbsoluteDeadline() - inTick)) {
+                    break;
+                }
+                previous = &t;
+            }
+
+            if (previous) {
+                mReady.insert_after(previous, *task);
+            }
+            else {
+                mReady.push_front(*task);
+            }
+        }
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void EDFScheduler<sched_task_t, queue_t, stats_t>::run() {
+
+        this->drainInbox();
+
+        release(mGetTick());
+
+        if (mReady.empty()) {
+            // no job released
+            this->idle();
+            return;
+        }
+
+        auto* task = static_cast<IEDFTask*>(&mReady.front());
+        const auto releaseRank = task->getRank();
+
+        this->mCurrentTask = task;
+        this->trace(TraceEvent::TaskStart, task);
+
+        if constexpr (stats_t::enabled) {
+            const auto start = mGetTick();
+            task->run();
+            this->recordRun(*task, mGetTick() - start, start - releaseRank);
+        }
+        else {
+            task->run();
+        }
+
+        this->trace(TraceEvent::TaskStop, task);
+
+        // Check if task is still linked after execution
+        if (task->isLinked()) {
+
+            // the job is complete, the task waits for its next release
+            this->detach(*task);
+
+            // later releases may have moved the cursor while the job was
+            // waiting, a release behind it would look far in the future
+            auto rank = releaseRank + task->getPeriod();
+            const auto cursorRank = this->mTasks.getCursor();
+
+            if (static_cast<int32_t>(rank - cursorRank) < 0) {
+                rank = cursorRank;
+            }
+
+            task->setRank(rank);
+            this->mTasks.push(*task);
+        }
+        else {
+            this->recordRemove(*task);
+        }
+
+        this->mCurrentTask = nullptr;
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    std::size_t EDFScheduler<sched_task_t, queue_t, stats_t>::size() const {
+        return base_t::size() + mReady.size();
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    bool EDFScheduler<sched_task_t, queue_t, stats_t>::empty() const {
+        return base_t::empty() && mReady.empty();
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void EDFScheduler<sched_task_t, queue_t, stats_t>::clear() {
+        if (this->mTrace || stats_t::enabled) {
+            for (auto& t : mReady) {
+                this->recordRemove(t);
+            }
+        }
+        mReady.clear();
+        base_t::clear();
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    template<typename stream_t>
+    void EDFScheduler<sched_task_t, queue_t, stats_t>::list(
+        stream_t&& inStream,
+        std::string_view inSeparator
+    ) {
+        for (auto& t : mReady) {
+            inStream << t.name() << inSeparator;
+        }
+        base_t::list(inStream, inSeparator);
+    }
+
+}
\ No newline at end of file
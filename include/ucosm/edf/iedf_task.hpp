@@ -0,0 +1,112 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/itask.hpp"
+#include <stdint.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Earliest deadline first task.
+     * The rank holds the release tick of the current job.
+     */
+    struct IEDFTask : ITask<uint32_t> {
+
+        using tick_t = uint32_t;
+
+        /**
+         * @brief Construct a new EDF task.
+         *
+         * @param inPeriod Interval between two releases.
+         * @param inDeadline Relative deadline, 0 for the period.
+         * @param inOffset Delay of the first release.
+         */
+        IEDFTask(tick_t inPeriod = 0, tick_t inDeadline = 0, tick_t inOffset = 0) :
+            mPeriod(inPeriod),
+            mDeadline(inDeadline),
+            mOffset(inOffset) {}
+
+        /**
+         * @brief Set the task period.
+         *
+         * @param inPeriod Period value.
+         */
+        void setPeriod(tick_t inPeriod) { mPeriod = inPeriod; }
+
+        /**
+         * @brief Get the task period.
+         *
+         * @return tick_t Period value.
+         */
+        tick_t getPeriod() const { return mPeriod; }
+
+        /**
+         * @brief Set the relative deadline.
+         *
+         * @param inDeadline Deadline value, 0 for the period.
+         */
+        void setDeadline(tick_t inDeadline) { mDeadline = inDeadline; }
+
+        /**
+         * @brief Get the relative deadline.
+         *
+         * @return tick_t Deadline value, the period if none was set.
+         */
+        tick_t getDeadline() const { return mDeadline ? mDeadline : mPeriod; }
+
+        /**
+         * @brief Set the delay of the first release, applied when the task is added.
+         *
+         * @param inOffset Offset value.
+         */
+        void setOffset(tick_t inOffset) { mOffset = inOffset; }
+
+        /**
+         * @brief Get the delay of the first release.
+         *
+         * @return tick_t Offset value.
+         */
+        tick_t getOffset() const { return mOffset; }
+
+        /**
+         * @brief Get the absolute deadline of the current job.
+         *
+         * @return tick_t Release tick plus the relative deadline.
+         */
+        tick_t getAbsoluteDeadline() const { return getRank() + getDeadline(); }
+
+    private:
+
+        tick_t mPeriod;
+        tick_t mDeadline;
+        tick_t mOffset;
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,407 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/cfs/icfs_task.hpp"
+#include "ucosm/core/ischeduler.hpp"
+#include "ucosm/core/rb_tree.hpp"
+#include "ucosm/core/work_stealing_deque.hpp"
+#include "ucosm/wakeup/thread_wakeup.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace ucosm {
+
+    /**
+     * @brief Completely fair executor running on several threads.
+     *
+     * Each worker thread owns a CFS timeline and runs its tasks like
+     * CFSScheduler: the task with the lowest weighted execution time runs
+     * first and its rank grows by its duration shifted by its priority.
+     *
+     * When a worker runs out of tasks, the busy workers hand over the task
+     * they just ran through a lock-free work-stealing deque, where the idle
+     * worker steals it. A task's execution time travels as its lag behind
+     * the timeline cursor, so a migrated task keeps its place relative to
+     * the other tasks of its new timeline.
+     *
+     * A task is held by a single worker at a time, in its inbox, timeline
+     * or deque, and only this worker runs it: a task never runs on two
+     * threads at once. Tasks leave the executor by calling removeTask()
+     * from their run() function.
+     *
+     * @tparam worker_count Number of worker threads.
+     * @tparam deque_capacity Capacity of each work-stealing deque, power of two.
+     */
+    template<std::size_t worker_count, std::size_t deque_capacity = 64>
+    struct ParallelCFSExecutor {
+
+        static_assert(worker_count > 0, "at least one worker is required");
+
+        using get_tick_t = ICFSTask::tick_t(*)();
+
+        /**
+         * @brief Construct a new executor, the workers are not started.
+         *
+         * @param inGetTick Clock used to measure the task durations, must be thread-safe.
+         */
+        ParallelCFSExecutor(get_tick_t inGetTick) :
+            mGetTick(inGetTick) {
+            for (auto& w : mWorkers) {
+                w.mExecutor = this;
+                w.setWakeup(&w.mThreadWakeup);
+            }
+        }
+
+        ParallelCFSExecutor(const ParallelCFSExecutor&) = delete;
+        ParallelCFSExecutor& operator=(const ParallelCFSExecutor&) = delete;
+
+        ~ParallelCFSExecutor();
+
+        /**
+         * @brief Posts a task to be added by a worker.
+         * Can be called from any thread, including from a running task.
+         * Tasks are spread over the workers in turn. The task is initialized
+         * by the worker, it must not be held by the executor already.
+         *
+         * @param inTask Task instance.
+         */
+        void post(ICFSTask& inTask);
+
+        /**
+         * @brief Posts a task to be added by a given worker.
+         *
+         * @param inTask Task instance.
+         * @param inWorker Worker index, modulo worker_count.
+         */
+        void post(ICFSTask& inTask, std::size_t inWorker);
+
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @return true if the workers were started.
+         * @return false if they are already running.
+         */
+        bool start();
+
+        /**
+         * @brief Stops and joins the worker threads.
+         * Each worker completes its current task, the tasks are kept
+         * and run again on the next start().
+         */
+        void stop();
+
+        bool isRunning() const { return mRunning; }
+
+        /**
+         * @brief Returns the number of tasks posted and not removed yet.
+         *
+         * @return std::size_t Number of tasks.
+         */
+        std::size_t size() const { return mTaskCount.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Returns the number of tasks taken from another worker.
+         *
+         * @return std::size_t Number of steals.
+         */
+        std::size_t stealCount() const { return mStealCount.load(std::memory_order_relaxed); }
+
+        static constexpr std::size_t workerCount() { return worker_count; }
+
+    private:
+
+        using itask_t = ITask<ICFSTask::rank_t>;
+
+        // the timeline and the inbox are the ready queue and the inbox of the scheduler
+        struct Worker : IScheduler<ICFSTask, ITask<int8_t>, RBTree> {
+
+            ~Worker();
+
+            void run() override { runOnce(); }
+
+            /**
+             * @brief Runs the next task of the timeline.
+             *
+             * @return true if a task was run.
+             * @return false if no task was found.
+             */
+            bool runOnce();
+
+            void loop();
+
+            // adds a task handed over by a worker, ranked by its lag
+            void adopt(ICFSTask& inTask);
+
+            ICFSTask* steal();
+
+            void donate(ICFSTask& inTask);
+
+            ParallelCFSExecutor* mExecutor = nullptr;
+            std::size_t mIndex = 0;
+            WorkStealingDeque<ICFSTask, deque_capacity> mDeque;
+            ThreadWakeup mThreadWakeup;
+            std::atomic<bool> mIdle { false };
+            std::thread mThread;
+        };
+
+        void notifyIdle();
+
+        get_tick_t mGetTick;
+        Worker mWorkers[worker_count];
+        std::atomic<std::size_t> mNextWorker { 0 };
+        std::atomic<std::size_t> mIdleCount { 0 };
+        std::atomic<std::size_t> mTaskCount { 0 };
+        std::atomic<std::size_t> mStealCount { 0 };
+        std::atomic<bool> mStop { false };
+        bool mRunning = false;
+
+    };
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    ParallelCFSExecutor<worker_count, deque_capacity>::~ParallelCFSExecutor() {
+
+        // the workers forget their tasks once joined
+        stop();
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::post(ICFSTask& inTask) {
+        post(inTask, mNextWorker.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::post(ICFSTask& inTask, std::size_t inWorker) {
+        auto& w = mWorkers[inWorker % worker_count];
+        mTaskCount.fetch_add(1, std::memory_order_acq_rel);
+        w.post(inTask);
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    bool ParallelCFSExecutor<worker_count, deque_capacity>::start() {
+
+        if (mRunning) {
+            return false;
+        }
+
+        mStop.store(false, std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < worker_count; i++) {
+            mWorkers[i].mIndex = i;
+            mWorkers[i].mThread = std::thread(&Worker::loop, &mWorkers[i]);
+        }
+
+        mRunning = true;
+        return true;
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::stop() {
+
+        if (!mRunning) {
+            return;
+        }
+
+        mStop.store(true, std::memory_order_release);
+
+        for (auto& w : mWorkers) {
+            w.mThreadWakeup.notify();
+        }
+
+        for (auto& w : mWorkers) {
+            w.mThread.join();
+        }
+
+        mRunning = false;
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::notifyIdle() {
+        for (auto& w : mWorkers) {
+            if (w.mIdle.load(std::memory_order_acquire)) {
+                w.mThreadWakeup.notify();
+                return;
+            }
+        }
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    ParallelCFSExecutor<worker_count, deque_capacity>::Worker::~Worker() {
+        this->mInbox.drain([] (itask_t&) {});
+        while (mDeque.pop()) {}
+        this->clear();
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::Worker::loop() {
+
+        // a hungry worker stays counted as idle until it runs a task
+        bool hungry = false;
+
+        while (!mExecutor->mStop.load(std::memory_order_acquire)) {
+
+            if (runOnce()) {
+                if (hungry) {
+                    hungry = false;
+                    mIdle.store(false, std::memory_order_release);
+                    mExecutor->mIdleCount.fetch_sub(1, std::memory_order_acq_rel);
+                }
+                continue;
+            }
+
+            if (!hungry) {
+                // nothing to run, ask the busy workers for a task
+                hungry = true;
+                mIdle.store(true, std::memory_order_release);
+                mExecutor->mIdleCount.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+            // the timeout bounds the wait if a hand-over notified another worker
+            mThreadWakeup.waitFor(std::chrono::milliseconds(1));
+        }
+
+        if (hungry) {
+            mIdle.store(false, std::memory_order_release);
+            mExecutor->mIdleCount.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    bool ParallelCFSExecutor<worker_count, deque_capacity>::Worker::runOnce() {
+
+        this->mInbox.drain(
+            [this] (itask_t& inTask) {
+                auto& task = static_cast<ICFSTask&>(inTask);
+                if (task.init()) {
+                    task.setRank(this->mTasks.getCursor());
+                    this->mTasks.push(task);
+                }
+                else {
+                    mExecutor->mTaskCount.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            }
+        );
+
+        if (!mDeque.empty() && !mExecutor->mIdleCount.load(std::memory_order_acquire)) {
+            // no worker is waiting anymore, take back the handed over tasks
+            while (auto* task = mDeque.pop()) {
+                adopt(*task);
+            }
+        }
+
+        if (this->mTasks.empty()) {
+
+            // take back a task that nobody stole, then look at the other workers
+            auto* task = mDeque.pop();
+
+            if (!task) {
+                task = steal();
+            }
+
+            if (!task) {
+                return false;
+            }
+
+            adopt(*task);
+        }
+
+        auto* task = static_cast<ICFSTask*>(this->mTasks.next());
+
+        const auto startTimeStamp = mExecutor->mGetTick();
+        const auto currentRank = task->getRank();
+
+        this->mTasks.setCursor(currentRank);
+        task->run();
+
+        // Check if task is still linked after execution
+        if (!task->isLinked()) {
+            mExecutor->mTaskCount.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+
+        auto taskDuration = mExecutor->mGetTick() - startTimeStamp;
+
+        taskDuration <<= task->getPriority();
+        taskDuration += currentRank;
+
+        task->setRank(taskDuration);
+        this->mTasks.sort(*task);
+
+        if (
+            mExecutor->mIdleCount.load(std::memory_order_acquire) &&
+            this->mTasks.size() > 1 &&
+            mDeque.empty()
+        ) {
+            // another worker is idle and this one has tasks waiting
+            donate(*task);
+        }
+
+        return true;
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::Worker::donate(ICFSTask& inTask) {
+
+        this->detach(inTask);
+
+        // the rank becomes the lag behind this timeline
+        inTask.setRank(inTask.getRank() - this->mTasks.getCursor());
+
+        if (!mDeque.push(&inTask)) {
+            adopt(inTask);
+            return;
+        }
+
+        mExecutor->notifyIdle();
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    void ParallelCFSExecutor<worker_count, deque_capacity>::Worker::adopt(ICFSTask& inTask) {
+        inTask.setRank(this->mTasks.getCursor() + inTask.getRank());
+        this->mTasks.push(inTask);
+    }
+
+    template<std::size_t worker_count, std::size_t deque_capacity>
+    ICFSTask* ParallelCFSExecutor<worker_count, deque_capacity>::Worker::steal() {
+
+        for (std::size_t i = 1; i < worker_count; i++) {
+
+            auto& victim = mExecutor->mWorkers[(mIndex + i) % worker_count];
+
+            if (auto* task = victim.mDeque.steal()) {
+                mExecutor->mStealCount.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        return nullptr;
+    }
+
+}
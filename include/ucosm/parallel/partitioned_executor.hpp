@@ -0,0 +1,747 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/core/task_inbox.hpp"
+#include "ucosm/core/task_stats.hpp"
+#include "ucosm/wakeup/thread_wakeup.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ucosm {
+
+    /**
+     * @brief Partitioned periodic executor.
+     *
+     * Runs one PeriodicScheduler per thread, each thread being pinned to
+     * a CPU on Linux. Every partition measures the execution time of its
+     * tasks over a window and publishes its utilization: posted tasks are
+     * placed on the least loaded partition, and a partition whose
+     * utilization exceeds the rebalance threshold moves one task per
+     * window to the least loaded partition.
+     *
+     * Tasks can also be migrated explicitly from any thread. A migration
+     * is carried out by the thread of the source partition between two
+     * runs, the task keeps its due tick and is neither deinitialized nor
+     * initialized again, so it never runs on two partitions at once.
+     * Tasks leave the executor by calling removeTask() from their run()
+     * function.
+     *
+     * @tparam partition_count Number of partitions and threads.
+     * @tparam max_tasks Maximum number of tasks per partition.
+     */
+    template<std::size_t partition_count, std::size_t max_tasks = 32>
+    struct PartitionedExecutor {
+
+        static_assert(partition_count > 0, "at least one partition is required");
+
+        using tick_t = IPeriodicTask::tick_t;
+        using get_tick_t = tick_t(*)();
+
+        /**
+         * @brief Construct a new executor, the partitions are not started.
+         * Partition i is pinned to CPU i by default.
+         *
+         * @param inGetTick Clock shared by the partitions, must be thread-safe.
+         * @param inTickDuration Duration of a tick, used to sleep between runs.
+         */
+        PartitionedExecutor(get_tick_t inGetTick, std::chrono::nanoseconds inTickDuration);
+
+        PartitionedExecutor(const PartitionedExecutor&) = delete;
+        PartitionedExecutor& operator=(const PartitionedExecutor&) = delete;
+
+        ~PartitionedExecutor();
+
+        /**
+         * @brief Set the CPU a partition thread is pinned to.
+         * Takes effect on the next start().
+         *
+         * @param inPartition Partition index.
+         * @param inCpu CPU index, negative to disable pinning.
+         * @return true if the partition index is valid.
+         */
+        bool setCpu(std::size_t inPartition, int inCpu);
+
+        /**
+         * @brief Set the load measurement window and the rebalance threshold.
+         *
+         * @param inWindow Window length in ticks.
+         * @param inThreshold Utilization in per mille above which a
+         * partition gives a task away, 1000 or more to disable rebalancing.
+         */
+        void setRebalance(tick_t inWindow, uint32_t inThreshold);
+
+        /**
+         * @brief Posts a task on the least loaded partition.
+         * Can be called from any thread. The task is initialized by the
+         * partition thread, it must not be held by the executor already.
+         *
+         * @param inTask Task instance.
+         * @return true if the task was posted.
+         * @return false if every partition is full.
+         */
+        bool post(IPeriodicTask& inTask);
+
+        /**
+         * @brief Posts a task on a given partition.
+         *
+         * @param inTask Task instance.
+         * @param inPartition Partition index.
+         * @return true if the task was posted.
+         * @return false if the partition is full or doesn't exist.
+         */
+        bool post(IPeriodicTask& inTask, std::size_t inPartition);
+
+        /**
+         * @brief Requests the migration of a task to another partition.
+         * Can be called from any thread, including from the task itself.
+         *
+         * @param inTask Task held by the executor.
+         * @param inPartition Destination partition index.
+         * @return true if the migration was requested.
+         * @return false if the task is unknown or the destination is full.
+         */
+        bool migrate(IPeriodicTask& inTask, std::size_t inPartition);
+
+        /**
+         * @brief Returns the partition holding a task.
+         *
+         * @param inTask Task instance.
+         * @return std::size_t Partition index, partition_count if the task is unknown.
+         */
+        std::size_t partitionOf(const IPeriodicTask& inTask) const;
+
+        /**
+         * @brief Returns the utilization measured over the last window.
+         *
+         * @param inPartition Partition index.
+         * @return uint32_t Utilization in per mille.
+         */
+        uint32_t utilization(std::size_t inPartition) const;
+
+        /**
+         * @brief Returns the number of tasks of a partition, migrating
+         * tasks being counted by their destination.
+         *
+         * @param inPartition Partition index.
+         * @return std::size_t Number of tasks.
+         */
+        std::size_t size(std::size_t inPartition) const;
+
+        /**
+         * @brief Returns the number of tasks of the executor.
+         *
+         * @return std::size_t Number of tasks.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the number of migrations done by the rebalancing.
+         *
+         * @return std::size_t Number of migrations.
+         */
+        std::size_t rebalanceCount() const { return mRebalanceCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Starts the partition threads.
+         *
+         * @return true if the partitions were started.
+         * @return false if they are already running.
+         */
+        bool start();
+
+        /**
+         * @brief Stops and joins the partition threads.
+         * The tasks are kept and run again on the next start().
+         */
+        void stop();
+
+        bool isRunning() const { return mRunning; }
+
+        static constexpr std::size_t partitionCount() { return partition_count; }
+
+    private:
+
+        struct Partition : PeriodicScheduler<ITask<int8_t>, SortedList, StatsTable<max_tasks>> {
+
+            using base_t = PeriodicScheduler<ITask<int8_t>, SortedList, StatsTable<max_tasks>>;
+            using itask_t = ITask<tick_t>;
+
+            Partition() : base_t(nullptr) {}
+
+            void setup(PartitionedExecutor& inExecutor, std::size_t inIndex);
+
+            void loop();
+
+            // runs the ready tasks and forgets the removed ones
+            void runReady();
+
+            // takes the new and migrated tasks
+            void takeArrivals();
+
+            void handleRequests();
+
+            // moves a task of this partition to another one
+            bool move(IPeriodicTask& inTask, std::size_t inPartition);
+
+            void rebalance(tick_t inNow);
+
+            struct Request {
+                IPeriodicTask* mTask;
+                std::size_t mPartition;
+            };
+
+            PartitionedExecutor* mExecutor = nullptr;
+            std::size_t mIndex = 0;
+            int mCpu = -1;
+            TaskInbox<itask_t> mNew;
+            TaskInbox<itask_t> mMigrated;
+            // guarded by the executor mutex
+            Request mRequests[max_tasks];
+            std::size_t mRequestCount = 0;
+            std::size_t mTaskCount = 0;
+            tick_t mWindowStart = 0;
+            std::atomic<uint32_t> mUtilization { 0 };
+            ThreadWakeup mThreadWakeup;
+            std::thread mThread;
+        };
+
+        struct Slot {
+            const IPeriodicTask* mTask = nullptr;
+            std::size_t mPartition = 0;
+        };
+
+        static constexpr std::size_t kSlotCount = partition_count * max_tasks;
+
+        // must be called with the mutex held
+        Slot* findSlot(const IPeriodicTask& inTask);
+        const Slot* findSlot(const IPeriodicTask& inTask) const;
+
+        void forget(const IPeriodicTask& inTask);
+
+        get_tick_t mGetTick;
+        std::chrono::nanoseconds mTickDuration;
+        std::atomic<tick_t> mWindow { 1000 };
+        std::atomic<uint32_t> mThreshold { 1000 };
+        Partition mPartitions[partition_count];
+        Slot mSlots[kSlotCount];
+        mutable std::mutex mMutex;
+        std::atomic<std::size_t> mRebalanceCount { 0 };
+        std::atomic<bool> mStop { false };
+        bool mRunning = false;
+
+    };
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    PartitionedExecutor<partition_count, max_tasks>::PartitionedExecutor(
+        get_tick_t inGetTick,
+        std::chrono::nanoseconds inTickDuration
+    ) :
+        mGetTick(inGetTick),
+        mTickDuration(inTickDuration) {
+
+        for (std::size_t i = 0; i < partition_count; i++) {
+            mPartitions[i].setup(*this, i);
+        }
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    PartitionedExecutor<partition_count, max_tasks>::~PartitionedExecutor() {
+
+        stop();
+
+        for (auto& p : mPartitions) {
+            p.mNew.drain([] (ITask<tick_t>&) {});
+            p.mMigrated.drain([] (ITask<tick_t>&) {});
+            p.clear();
+        }
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    bool PartitionedExecutor<partition_count, max_tasks>::setCpu(std::size_t inPartition, int inCpu) {
+
+        if (inPartition >= partition_count) {
+            return false;
+        }
+
+        mPartitions[inPartition].mCpu = inCpu;
+        return true;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::setRebalance(tick_t inWindow, uint32_t inThreshold) {
+        mWindow.store(inWindow ? inWindow : 1, std::memory_order_relaxed);
+        mThreshold.store(inThreshold, std::memory_order_relaxed);
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    bool PartitionedExecutor<partition_count, max_tasks>::post(IPeriodicTask& inTask) {
+
+        std::size_t best = partition_count;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            for (std::size_t i = 0; i < partition_count; i++) {
+
+                const auto& p = mPartitions[i];
+
+                if (p.mTaskCount == max_tasks) {
+                    continue;
+                }
+
+                if (best == partition_count) {
+                    best = i;
+                    continue;
+                }
+
+                const auto& b = mPartitions[best];
+                const auto load = p.mUtilization.load(std::memory_order_relaxed);
+                const auto bestLoad = b.mUtilization.load(std::memory_order_relaxed);
+
+                if (load < bestLoad || (load == bestLoad && p.mTaskCount < b.mTaskCount)) {
+                    best = i;
+                }
+            }
+        }
+
+        return (best != partition_count) && post(inTask, best);
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    bool PartitionedExecutor<partition_count, max_tasks>::post(IPeriodicTask& inTask, std::size_t inPartition) {
+
+        if (inPartition >= partition_count) {
+            return false;
+        }
+
+        auto& p = mPartitions[inPartition];
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            if (p.mTaskCount == max_tasks || findSlot(inTask)) {
+                return false;
+            }
+
+            auto* slot = std::find_if(
+                mSlots,
+                mSlots + kSlotCount,
+                [] (const Slot& s) { return !s.mTask; }
+            );
+
+            slot->mTask = &inTask;
+            slot->mPartition = inPartition;
+            p.mTaskCount++;
+        }
+
+        p.mNew.push(inTask);
+        p.mThreadWakeup.notify();
+        return true;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    bool PartitionedExecutor<partition_count, max_tasks>::migrate(IPeriodicTask& inTask, std::size_t inPartition) {
+
+        if (inPartition >= partition_count) {
+            return false;
+        }
+
+        std::size_t source;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            auto* slot = findSlot(inTask);
+
+            if (!slot) {
+                return false;
+            }
+
+            if (slot->mPartition == inPartition) {
+                return true;
+            }
+
+            auto& from = mPartitions[slot->mPartition];
+            auto& to = mPartitions[inPartition];
+
+            if (to.mTaskCount == max_tasks || from.mRequestCount == max_tasks) {
+                return false;
+            }
+
+            from.mRequests[from.mRequestCount++] = { &inTask, inPartition };
+            source = slot->mPartition;
+        }
+
+        mPartitions[source].mThreadWakeup.notify();
+        return true;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    std::size_t PartitionedExecutor<partition_count, max_tasks>::partitionOf(const IPeriodicTask& inTask) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const auto* slot = findSlot(inTask);
+        return slot ? slot->mPartition : partition_count;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    uint32_t PartitionedExecutor<partition_count, max_tasks>::utilization(std::size_t inPartition) const {
+        return mPartitions[inPartition].mUtilization.load(std::memory_order_relaxed);
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    std::size_t PartitionedExecutor<partition_count, max_tasks>::size(std::size_t inPartition) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPartitions[inPartition].mTaskCount;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    std::size_t PartitionedExecutor<partition_count, max_tasks>::size() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::size_t count = 0;
+        for (const auto& p : mPartitions) {
+            count += p.mTaskCount;
+        }
+        return count;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    bool PartitionedExecutor<partition_count, max_tasks>::start() {
+
+        if (mRunning) {
+            return false;
+        }
+
+        mStop.store(false, std::memory_order_relaxed);
+
+        for (auto& p : mPartitions) {
+
+            p.mThread = std::thread(&Partition::loop, &p);
+
+#if defined(__linux__)
+            if (p.mCpu >= 0 && p.mCpu < CPU_SETSIZE) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(p.mCpu, &cpus);
+                // the thread runs unpinned if the CPU isn't available
+                pthread_setaffinity_np(p.mThread.native_handle(), sizeof(cpus), &cpus);
+            }
+#endif
+        }
+
+        mRunning = true;
+        return true;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::stop() {
+
+        if (!mRunning) {
+            return;
+        }
+
+        mStop.store(true, std::memory_order_release);
+
+        for (auto& p : mPartitions) {
+            p.mThreadWakeup.notify();
+        }
+
+        for (auto& p : mPartitions) {
+            p.mThread.join();
+        }
+
+        mRunning = false;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    auto PartitionedExecutor<partition_count, max_tasks>::findSlot(const IPeriodicTask& inTask) -> Slot* {
+        for (auto& s : mSlots) {
+            if (s.mTask == &inTask) {
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    auto PartitionedExecutor<partition_count, max_tasks>::findSlot(const IPeriodicTask& inTask) const -> const Slot* {
+        for (const auto& s : mSlots) {
+            if (s.mTask == &inTask) {
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::forget(const IPeriodicTask& inTask) {
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (auto* slot = findSlot(inTask)) {
+            mPartitions[slot->mPartition].mTaskCount--;
+            slot->mTask = nullptr;
+        }
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::Partition::setup(
+        PartitionedExecutor& inExecutor,
+        std::size_t inIndex
+    ) {
+        mExecutor = &inExecutor;
+        mIndex = inIndex;
+        mCpu = static_cast<int>(inIndex);
+        this->mGetTick = inExecutor.mGetTick;
+        this->setWakeup(&mThreadWakeup);
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::Partition::loop() {
+
+        auto* executor = mExecutor;
+
+        mWindowStart = executor->mGetTick();
+
+        while (!executor->mStop.load(std::memory_order_acquire)) {
+
+            handleRequests();
+            runReady();
+
+            const auto now = executor->mGetTick();
+            const auto window = executor->mWindow.load(std::memory_order_relaxed);
+
+            const tick_t elapsed = now - mWindowStart;
+
+            if (elapsed >= window) {
+                rebalance(now);
+                continue;
+            }
+
+            // sleep until the next task or the window end, whichever comes first
+            const auto ticks = std::min<tick_t>(this->ticksUntilNext(), window - elapsed);
+
+            if (ticks) {
+                mThreadWakeup.waitFor(executor->mTickDuration * ticks);
+            }
+        }
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::Partition::takeArrivals() {
+
+        mNew.drain(
+            [this] (itask_t& inTask) {
+                auto& task = static_cast<IPeriodicTask&>(inTask);
+                if (!this->addTask(task)) {
+                    mExecutor->forget(task);
+                }
+            }
+        );
+
+        mMigrated.drain(
+            [this] (itask_t& inTask) {
+
+                auto& task = static_cast<IPeriodicTask&>(inTask);
+                const auto cursor = this->mTasks.getCursor();
+
+                // a task that is already due runs next
+                if (static_cast<int32_t>(task.getRank() - cursor) < 0) {
+                    task.setRank(cursor);
+                }
+
+                this->mTasks.push(task);
+            }
+        );
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::Partition::handleRequests() {
+
+        Request requests[max_tasks];
+        std::size_t count;
+
+        {
+            std::lock_guard<std::mutex> lock(mExecutor->mMutex);
+            count = mRequestCount;
+            std::copy(mRequests, mRequests + count, requests);
+            mRequestCount = 0;
+        }
+
+        // a task migrated to this partition is pushed before the requests
+        // that target it are visible, take it first
+        takeArrivals();
+
+        for (std::size_t i = 0; i < count; i++) {
+            move(*requests[i].mTask, requests[i].mPartition);
+        }
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::Partition::runReady() {
+
+        const auto tick = mExecutor->mGetTick();
+
+        while (auto* task = this->runNext(tick)) {
+
+            if (!task->isLinked()) {
+                mExecutor->forget(*task);
+                continue;
+            }
+
+            if (!this->isParked(*task) && task->getRank() == tick) {
+                // the task yielded
+                break;
+            }
+        }
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    bool PartitionedExecutor<partition_count, max_tasks>::Partition::move(
+        IPeriodicTask& inTask,
+        std::size_t inPartition
+    ) {
+
+        auto& to = mExecutor->mPartitions[inPartition];
+
+        {
+            std::lock_guard<std::mutex> lock(mExecutor->mMutex);
+
+            // the slot is looked up first, a removed task may not exist anymore
+            auto* slot = mExecutor->findSlot(inTask);
+
+            if (!slot || slot->mPartition == inPartition || to.mTaskCount == max_tasks) {
+                return false;
+            }
+
+            if (slot->mPartition != mIndex) {
+                // the task was moved since the request, forward it
+                auto& owner = mExecutor->mPartitions[slot->mPartition];
+                if (owner.mRequestCount < max_tasks) {
+                    owner.mRequests[owner.mRequestCount++] = { &inTask, inPartition };
+                    owner.mThreadWakeup.notify();
+                }
+                return false;
+            }
+
+            if (this->isParked(inTask)) {
+                // only this partition can resume it
+                return false;
+            }
+
+            this->detach(inTask);
+
+            slot->mPartition = inPartition;
+            mTaskCount--;
+            to.mTaskCount++;
+
+            // pushed under the lock, before any request for the task reaches
+            // the destination
+            to.mMigrated.push(inTask);
+        }
+
+        to.mThreadWakeup.notify();
+        return true;
+    }
+
+    template<std::size_t partition_count, std::size_t max_tasks>
+    void PartitionedExecutor<partition_count, max_tasks>::Partition::rebalance(tick_t inNow) {
+
+        const uint64_t elapsed = static_cast<tick_t>(inNow - mWindowStart);
+
+        uint64_t busy = 0;
+
+        this->forEachStats(
+            [&] (IPeriodicTask&, const TaskStats& inStats) {
+                busy += inStats.totalTicks;
+            }
+        );
+
+        const auto load = static_cast<uint32_t>(std::min<uint64_t>(busy * 1000 / elapsed, 1000));
+        mUtilization.store(load, std::memory_order_relaxed);
+
+        if (load > mExecutor->mThreshold.load(std::memory_order_relaxed) && partition_count > 1) {
+
+            // least loaded partition
+            std::size_t target = partition_count;
+            uint32_t targetLoad = load;
+
+            for (const auto& p : mExecutor->mPartitions) {
+                const auto l = p.mUtilization.load(std::memory_order_relaxed);
+                if (&p != this && l < targetLoad) {
+                    target = p.mIndex;
+                    targetLoad = l;
+                }
+            }
+
+            // the task whose load is the closest to half of the gap,
+            // moving a task heavier than the gap wouldn't help
+            const uint32_t gap = load - targetLoad;
+            IPeriodicTask* candidate = nullptr;
+            uint32_t candidateDistance = gap;
+
+            if (target != partition_count) {
+                this->forEachStats(
+                    [&] (IPeriodicTask& inTask, const TaskStats& inStats) {
+
+                        const auto taskLoad = static_cast<uint32_t>(inStats.totalTicks * 1000 / elapsed);
+
+                        if (!taskLoad || taskLoad >= gap || this->isParked(inTask)) {
+                            return;
+                        }
+
+                        const uint32_t distance = (taskLoad > gap / 2) ? taskLoad - gap / 2 : gap / 2 - taskLoad;
+
+                        if (distance < candidateDistance) {
+                            candidate = &inTask;
+                            candidateDistance = distance;
+                        }
+                    }
+                );
+            }
+
+            if (candidate && move(*candidate, target)) {
+                mExecutor->mRebalanceCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        this->resetStats();
+        mWindowStart = inNow;
+    }
+
+}
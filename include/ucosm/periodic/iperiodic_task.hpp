@@ -39,6 +39,35 @@ namespace ucosm {
 
         using tick_t = uint32_t;
 
+        /**
+         * @brief Rescheduling mode.
+         * - Free     : next release at the dispatch tick plus the period,
+         *              lateness permanently shifts the phase.
+         * - CatchUp  : next release at the previous release plus the period,
+         *              every missed release runs.
+         * - Skip     : phase-locked, missed releases are dropped and the task
+         *              waits for the next aligned release.
+         * - Compress : phase-locked, missed releases are merged into a single
+         *              run at the last missed release.
+         */
+        enum class PhaseMode : uint8_t {
+            Free,
+            CatchUp,
+            Skip,
+            Compress
+        };
+
+        /**
+         * @brief Kind of deadline miss.
+         * - LateStart : the task started later than its release by more
+         *               than its relative deadline.
+         * - Overrun   : the task ran longer than its period.
+         */
+        enum class DeadlineMiss : uint8_t {
+            LateStart,
+            Overrun
+        };
+
         IPeriodicTask(tick_t inPeriod = 0) :
             mPeriod(inPeriod) {}
 
@@ -56,10 +85,140 @@ namespace ucosm {
          */
         tick_t getPeriod() const { return mPeriod; }
 
+        /**
+         * @brief Set the rescheduling mode.
+         *
+         * @param inMode Phase mode.
+         */
+        void setPhaseMode(PhaseMode inMode) { mPhaseMode = inMode; }
+
+        /**
+         * @brief Get the rescheduling mode.
+         *
+         * @return PhaseMode Phase mode.
+         */
+        PhaseMode getPhaseMode() const { return mPhaseMode; }
+
+        /**
+         * @brief Set the relative deadline, checked by the schedulers
+         * against the start lateness and the run duration.
+         *
+         * @param inDeadline Tolerated start lateness, 0 disables the checks.
+         */
+        void setDeadline(tick_t inDeadline) { mDeadline = inDeadline; }
+
+        /**
+         * @brief Get the relative deadline.
+         *
+         * @return tick_t Deadline value, 0 if the checks are disabled.
+         */
+        tick_t getDeadline() const { return mDeadline; }
+
+        /**
+         * @brief Get the number of late starts.
+         *
+         * @return uint16_t Late start count, wraps around.
+         */
+        uint16_t getLateStarts() const { return mLateStarts; }
+
+        /**
+         * @brief Get the number of overruns.
+         *
+         * @return uint16_t Overrun count, wraps around.
+         */
+        uint16_t getOverruns() const { return mOverruns; }
+
+        /**
+         * @brief Clears the deadline miss counters.
+         */
+        void resetDeadlineMisses() { mLateStarts = mOverruns = 0; }
+
+        /**
+         * @brief Called by the scheduler after a run that missed its deadline.
+         * Runs in the scheduler context, the interrupt context with the
+         * RT scheduler, so it must be short and must not allocate.
+         *
+         * @param inMiss Kind of miss.
+         * @param inTicks Start lateness or run duration.
+         */
+        virtual void onDeadlineMiss(DeadlineMiss /*inMiss*/, tick_t /*inTicks*/) {}
+
+        /**
+         * @brief Checks a run against the deadline, updates the counters
+         * and calls onDeadlineMiss() for each miss.
+         * Typically called by the scheduler.
+         *
+         * @param inLateness Start tick minus release tick.
+         * @param inDuration Run duration.
+         * @return uint8_t Number of misses, 0 to 2.
+         */
+        uint8_t checkDeadline(tick_t inLateness, tick_t inDuration);
+
+        /**
+         * @brief Computes the rank of the next release.
+         * A null period always reschedules at the dispatch tick.
+         *
+         * @param inRank Rank of the release that just ran.
+         * @param inTick Tick at which the release was dispatched.
+         * @return tick_t Next release rank.
+         */
+        tick_t nextRelease(tick_t inRank, tick_t inTick) const;
+
     private:
 
         tick_t mPeriod;
+        tick_t mDeadline = 0;
+        uint16_t mLateStarts = 0;
+        uint16_t mOverruns = 0;
+        PhaseMode mPhaseMode = PhaseMode::Free;
 
     };
 
+    inline IPeriodicTask::tick_t IPeriodicTask::nextRelease(tick_t inRank, tick_t inTick) const {
+
+        if (mPhaseMode == PhaseMode::Free || mPeriod == 0) {
+            return inTick + mPeriod;
+        }
+
+        // number of releases due since the one that just ran
+        const tick_t missed = static_cast<tick_t>(inTick - inRank) / mPeriod;
+
+        switch (mPhaseMode) {
+            case PhaseMode::Skip:
+                return inRank + (missed + 1) * mPeriod;
+            case PhaseMode::Compress:
+                if (missed) {
+                    return inRank + missed * mPeriod;
+                }
+                break;
+            default:
+                break;
+        }
+
+        return inRank + mPeriod;
+    }
+
+    inline uint8_t IPeriodicTask::checkDeadline(tick_t inLateness, tick_t inDuration) {
+
+        if (!mDeadline) {
+            return 0;
+        }
+
+        uint8_t misses = 0;
+
+        if (inLateness > mDeadline) {
+            mLateStarts++;
+            misses++;
+            onDeadlineMiss(DeadlineMiss::LateStart, inLateness);
+        }
+
+        if (mPeriod && inDuration > mPeriod) {
+            mOverruns++;
+            misses++;
+            onDeadlineMiss(DeadlineMiss::Overrun, inDuration);
+        }
+
+        return misses;
+    }
+
 }
\ No newline at end of file
@@ -29,6 +29,8 @@
 
 #include "ucosm/core/ischeduler.hpp"
 #include "iperiodic_task.hpp"
+#include <cstddef>
+#include <limits>
 
 namespace ucosm {
 
@@ -36,18 +38,26 @@ namespace ucosm {
      * @brief Periodic scheduler.
      *
      * @tparam sched_task_t Scheduler task type
+     * @tparam queue_t Ready queue type (SortedList, PairingHeap, TimingWheel, RBTree,
+     * FixedRankTable<N>::type)
+     * @tparam stats_t Statistics policy (NoStats, StatsTable<N>)
      */
-    template<typename sched_task_t = ITask<int8_t>>
-    struct PeriodicScheduler : IScheduler<IPeriodicTask, sched_task_t> {
+    template<
+        typename sched_task_t = ITask<int8_t>,
+        template<typename> typename queue_t = SortedList,
+        typename stats_t = NoStats
+    >
+    struct PeriodicScheduler : IScheduler<IPeriodicTask, sched_task_t, queue_t, stats_t> {
 
         using get_tick_t = IPeriodicTask::tick_t(*)();
 
         PeriodicScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
-            IScheduler<IPeriodicTask, sched_task_t>(inIdleTask),
+            IScheduler<IPeriodicTask, sched_task_t, queue_t, stats_t>(inIdleTask),
             mGetTick(inGetTick) {}
 
         /**
          * @brief Delay the task.
+         * Has no effect on a parked task, which runs once resumed.
          *
          * @param inDelay Delay value.
          */
@@ -58,66 +68,267 @@ namespace ucosm {
          */
         void run() override;
 
+        /**
+         * @brief Runs every task ready at a single sampled tick.
+         * A task rescheduled to the sampled tick itself (zero period)
+         * ends the burst so that yielding tasks don't loop forever.
+         * The idle function is called if no task was ready.
+         *
+         * @return std::size_t Number of executed tasks.
+         */
+        std::size_t runReady();
+
+        /**
+         * @brief Runs the tasks ready at a single sampled tick until one of
+         * the budgets is exhausted.
+         *
+         * @param inMaxTasks Maximum number of tasks to execute.
+         * @param inMaxTicks Maximum burst duration, checked after each task.
+         * @return std::size_t Number of executed tasks.
+         */
+        std::size_t runFor(std::size_t inMaxTasks, IPeriodicTask::tick_t inMaxTicks);
+
+        /**
+         * @brief Returns the number of ticks until the next task is ready.
+         *
+         * @return IPeriodicTask::tick_t 0 if a task is ready, the maximum
+         * tick value if the scheduler is empty or only holds parked tasks.
+         */
+        IPeriodicTask::tick_t ticksUntilNext();
+
+        /**
+         * @brief Runs the ready tasks and sleeps until the next one is due.
+         * Returns once the scheduler is empty, posted and parked tasks included.
+         * The sleep function should return early when the wake-up set
+         * with setWakeup() is notified (see ThreadWakeup::waitFor).
+         *
+         * @tparam sleep_t Callable taking the number of ticks to sleep.
+         * @param inSleep Sleep function, may return early.
+         */
+        template<typename sleep_t>
+        void runForever(sleep_t&& inSleep);
+
+        /**
+         * @brief Returns the number of deadline misses of every task,
+         * see IPeriodicTask::setDeadline().
+         *
+         * @return std::size_t Deadline miss count.
+         */
+        std::size_t deadlineMisses() const { return mDeadlineMisses; }
+
     protected:
 
+        /**
+         * @brief Runs the next task if it is ready at the given tick.
+         *
+         * @param inTick Current tick.
+         * @return IPeriodicTask* Executed task or nullptr if none was ready.
+         */
+        IPeriodicTask* runNext(IPeriodicTask::tick_t inTick);
+
         get_tick_t mGetTick;
 
+        std::size_t mDeadlineMisses = 0;
+
     };
 
-    template<typename sched_rank_t>
-    void PeriodicScheduler<sched_rank_t>::setDelay(
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void PeriodicScheduler<sched_task_t, queue_t, stats_t>::setDelay(
         IPeriodicTask& inTask,
         IPeriodicTask::tick_t inDelay
     ) {
+
+        if (this->isParked(inTask)) {
+            // resume() pushes it back at the cursor
+            return;
+        }
+
         inTask.setRank(mGetTick() + inDelay);
         this->sortTask(inTask);
+        this->notify();
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    void PeriodicScheduler<sched_task_t, queue_t, stats_t>::run() {
+
+        this->drainInbox();
+
+        if (!runNext(mGetTick())) {
+            // no task to run
+            this->idle();
+        }
+
     }
 
-    template<typename sched_rank_t>
-    void PeriodicScheduler<sched_rank_t>::run() {
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    std::size_t PeriodicScheduler<sched_task_t, queue_t, stats_t>::runReady() {
+
+        this->drainInbox();
 
         const auto tick = mGetTick();
 
-        this->mCurrentTask = this->getNextTask();
+        std::size_t count = 0;
 
-        if (this->mCurrentTask) {
+        while (auto* task = runNext(tick)) {
 
-            const auto cursorRank = this->mCursorTask.getRank();
-            const auto deltaTask = this->mCurrentTask->getRank() - cursorRank;
-            const auto deltaTick = tick - cursorRank;
+            count++;
 
-            if (deltaTick < deltaTask) {
-                // task is not ready
-                this->mCurrentTask = nullptr;
+            if (task->isLinked() && !this->isParked(*task) && task->getRank() == tick) {
+                // the task yielded
+                break;
             }
+        }
 
+        if (!count) {
+            this->idle();
         }
 
-        if (!this->mCurrentTask) {
-            // no task to run
-            if (this->mIdleTask) {
-                this->mIdleTask();
+        return count;
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    std::size_t PeriodicScheduler<sched_task_t, queue_t, stats_t>::runFor(
+        std::size_t inMaxTasks,
+        IPeriodicTask::tick_t inMaxTicks
+    ) {
+
+        this->drainInbox();
+
+        const auto tick = mGetTick();
+
+        std::size_t count = 0;
+
+        while (count < inMaxTasks) {
+
+            auto* task = runNext(tick);
+
+            if (!task) {
+                break;
+            }
+
+            count++;
+
+            if (task->isLinked() && !this->isParked(*task) && task->getRank() == tick) {
+                // the task yielded
+                break;
+            }
+
+            if (static_cast<IPeriodicTask::tick_t>(mGetTick() - tick) >= inMaxTicks) {
+                break;
+            }
+        }
+
+        if (!count) {
+            this->idle();
+        }
+
+        return count;
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    IPeriodicTask::tick_t PeriodicScheduler<sched_task_t, queue_t, stats_t>::ticksUntilNext() {
+
+        if (this->mTasks.empty()) {
+            // nothing scheduled until a parked task is resumed
+            return std::numeric_limits<IPeriodicTask::tick_t>::max();
+        }
+
+        const auto cursorRank = this->mTasks.getCursor();
+        const IPeriodicTask::tick_t deltaTask = this->getNextRank() - cursorRank;
+        const IPeriodicTask::tick_t deltaTick = mGetTick() - cursorRank;
+
+        if (deltaTick >= deltaTask) {
+            // a task is ready
+            return 0;
+        }
+
+        return deltaTask - deltaTick;
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    template<typename sleep_t>
+    void PeriodicScheduler<sched_task_t, queue_t, stats_t>::runForever(sleep_t&& inSleep) {
+
+        for (;;) {
+
+            runReady();
+
+            if (!this->mInbox.empty() || !this->mResumed.empty()) {
+                // posted or resumed while the tasks ran
+                continue;
+            }
+
+            if (this->empty()) {
+                break;
+            }
+
+            if (const auto ticks = ticksUntilNext()) {
+                inSleep(ticks);
+            }
+        }
+
+    }
+
+    template<typename sched_task_t, template<typename> typename queue_t, typename stats_t>
+    IPeriodicTask* PeriodicScheduler<sched_task_t, queue_t, stats_t>::runNext(IPeriodicTask::tick_t inTick) {
+
+        auto* task = this->getNextTask();
+
+        if (!task) {
+            return nullptr;
+        }
+
+        const auto cursorRank = this->mTasks.getCursor();
+        const auto deltaTask = task->getRank() - cursorRank;
+        const auto deltaTick = inTick - cursorRank;
+
+        if (deltaTick < deltaTask) {
+            // task is not ready
+            return nullptr;
+        }
+
+        const auto taskRank = task->getRank();
+
+        this->mCurrentTask = task;
+        this->mTasks.setCursor(taskRank);
+
+        this->trace(TraceEvent::TaskStart, task);
+
+        if (stats_t::enabled || task->getDeadline()) {
+            // the burst tick may be older than the actual start
+            const IPeriodicTask::tick_t start = mGetTick();
+            task->run();
+            const IPeriodicTask::tick_t duration = mGetTick() - start;
+            this->recordRun(*task, duration, start - taskRank);
+
+            if (const auto misses = task->checkDeadline(start - taskRank, duration)) {
+                mDeadlineMisses += misses;
+                this->trace(TraceEvent::DeadlineMiss, task, misses);
             }
-            return;
+        }
+        else {
+            task->run();
         }
 
-        this->mCursorTask.setRank(this->mCurrentTask->getRank());
-        this->mCurrentTask->run();
+        this->trace(TraceEvent::TaskStop, task);
 
-        // Check if task is still linked after execution
-        if (this->mCurrentTask->isLinked()) {
+        if (this->isParked(*task)) {
+            // the task waits for resume()
+        }
+        else if (task->isLinked()) {
 
             // the task is still in the list
             // update the task rank
-            this->mCurrentTask->setRank(
-                tick +
-                this->mCurrentTask->getPeriod()
-            );
+            task->setRank(task->nextRelease(taskRank, inTick));
 
-            this->sortTask(*this->mCurrentTask);
+            this->sortTask(*task);
+        }
+        else {
+            this->recordRemove(*task);
         }
 
         this->mCurrentTask = nullptr;
+        return task;
     }
 
 }
\ No newline at end of file
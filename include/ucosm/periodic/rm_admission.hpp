@@ -0,0 +1,347 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "iperiodic_task.hpp"
+#include <stdint.h>
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Admission control of periodic tasks.
+     *
+     * Keeps the declared worst case execution time of the tasks it admits
+     * and checks, before adding a task to a scheduler, that every task
+     * still completes within its period.
+     * The default analysis matches the release ordered dispatch of
+     * PeriodicScheduler and RTScheduler. The rate monotonic analyses
+     * assume that the shortest periods have the highest priority, they
+     * only hold for a dispatcher using such priorities.
+     * The period is read from the task at each check. The table doesn't
+     * own the tasks: a task keeps counting until remove() is called, which
+     * must happen before the task is destroyed.
+     *
+     * @tparam max_tasks Maximum number of admitted tasks.
+     */
+    template<std::size_t max_tasks>
+    struct RMAdmission {
+
+        static_assert(max_tasks > 0, "null capacity");
+
+        using tick_t = IPeriodicTask::tick_t;
+
+        /**
+         * @brief Schedulability test.
+         * - ReleaseOrder     : tasks run by release tick and to completion.
+         *                      A task holds a single job, so a release waits
+         *                      at most for one job of every other task.
+         * - UtilizationBound : rate monotonic, Liu and Layland bound extended
+         *                      with the blocking by one job of a longer
+         *                      period task, O(n²) but pessimistic.
+         * - ResponseTime     : rate monotonic, non-preemptive response time
+         *                      analysis, iterates until the start times settle.
+         */
+        enum class Analysis : uint8_t {
+            ReleaseOrder,
+            UtilizationBound,
+            ResponseTime
+        };
+
+        RMAdmission(Analysis inAnalysis = Analysis::ReleaseOrder) :
+            mAnalysis(inAnalysis) {}
+
+        /**
+         * @brief Set the schedulability test.
+         *
+         * @param inAnalysis Analysis used by the next checks.
+         */
+        void setAnalysis(Analysis inAnalysis) { mAnalysis = inAnalysis; }
+
+        /**
+         * @brief Get the schedulability test.
+         *
+         * @return Analysis Current analysis.
+         */
+        Analysis getAnalysis() const { return mAnalysis; }
+
+        /**
+         * @brief Adds a task to a scheduler if the task set stays schedulable.
+         *
+         * @tparam scheduler_t Scheduler type, taking IPeriodicTask references.
+         * @param inScheduler Scheduler instance.
+         * @param inTask Task instance, with a non null period.
+         * @param inWcet Worst case execution time of the task, in scheduler ticks.
+         * @return true if the task was admitted and added.
+         * @return false otherwise.
+         */
+        template<typename scheduler_t>
+        bool addTask(scheduler_t& inScheduler, IPeriodicTask& inTask, tick_t inWcet);
+
+        /**
+         * @brief Tells if the admitted tasks and a given task would be schedulable.
+         * The declared execution time replaces the current one if the task
+         * was already admitted.
+         *
+         * @param inTask Task instance.
+         * @param inWcet Worst case execution time of the task.
+         * @return true if the task could be admitted.
+         * @return false otherwise.
+         */
+        bool isSchedulable(const IPeriodicTask& inTask, tick_t inWcet) const;
+
+        /**
+         * @brief Forgets a task, without removing it from its scheduler.
+         * Must be called when the task leaves its scheduler, at the latest
+         * before it is destroyed.
+         *
+         * @param inTask Admitted task.
+         */
+        void remove(const IPeriodicTask& inTask);
+
+        /**
+         * @brief Returns the declared utilization of the admitted tasks.
+         *
+         * @return uint32_t Utilization in per mille, rounded up.
+         */
+        uint32_t utilization() const;
+
+        /**
+         * @brief Returns the number of admitted tasks.
+         *
+         * @return std::size_t Number of tasks.
+         */
+        std::size_t size() const { return mCount; }
+
+    private:
+
+        struct Entry {
+            const IPeriodicTask* task = nullptr;
+            tick_t wcet = 0;
+        };
+
+        /**
+         * @brief Runs the analysis on the first entries of a table.
+         *
+         * @param inEntries Task table.
+         * @param inCount Number of tasks.
+         * @return true if the tasks are schedulable.
+         * @return false otherwise.
+         */
+        bool check(const Entry* inEntries, std::size_t inCount) const;
+
+        static uint32_t ppm(tick_t inWcet, tick_t inPeriod) {
+            return static_cast<uint32_t>((uint64_t(inWcet) * 1000000 + inPeriod - 1) / inPeriod);
+        }
+
+        Entry mEntries[max_tasks];
+        std::size_t mCount = 0;
+        Analysis mAnalysis;
+
+    };
+
+    template<std::size_t max_tasks>
+    template<typename scheduler_t>
+    bool RMAdmission<max_tasks>::addTask(scheduler_t& inScheduler, IPeriodicTask& inTask, tick_t inWcet) {
+
+        if (inTask.isLinked() || !isSchedulable(inTask, inWcet) || !inScheduler.addTask(inTask)) {
+            return false;
+        }
+
+        // a task that left its scheduler without being forgotten is replaced,
+        // isSchedulable() checked that there is room for the task
+        remove(inTask);
+        mEntries[mCount].task = &inTask;
+        mEntries[mCount].wcet = inWcet;
+        mCount++;
+        return true;
+    }
+
+    template<std::size_t max_tasks>
+    bool RMAdmission<max_tasks>::isSchedulable(const IPeriodicTask& inTask, tick_t inWcet) const {
+
+        // the admitted tasks with the candidate, which replaces its own entry
+        Entry candidates[max_tasks];
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < mCount; i++) {
+            if (mEntries[i].task != &inTask) {
+                candidates[count++] = mEntries[i];
+            }
+        }
+
+        if (count == max_tasks) {
+            // table full
+            return false;
+        }
+
+        candidates[count].task = &inTask;
+        candidates[count].wcet = inWcet;
+
+        return check(candidates, count + 1);
+    }
+
+    template<std::size_t max_tasks>
+    void RMAdmission<max_tasks>::remove(const IPeriodicTask& inTask) {
+        for (std::size_t i = 0; i < mCount; i++) {
+            if (mEntries[i].task == &inTask) {
+                mEntries[i] = mEntries[--mCount];
+                return;
+            }
+        }
+    }
+
+    template<std::size_t max_tasks>
+    uint32_t RMAdmission<max_tasks>::utilization() const {
+
+        uint64_t total = 0;
+
+        for (std::size_t i = 0; i < mCount; i++) {
+            total += ppm(mEntries[i].wcet, mEntries[i].task->getPeriod());
+        }
+
+        return static_cast<uint32_t>((total + 999) / 1000);
+    }
+
+    template<std::size_t max_tasks>
+    bool RMAdmission<max_tasks>::check(const Entry* inEntries, std::size_t inCount) const {
+
+        // n (2^(1/n) - 1) in parts per million, ln(2) beyond 10 tasks
+        static constexpr uint32_t kBounds[] = {
+            1000000, 828427, 779763, 756828, 743491,
+            734772, 728626, 724061, 720537, 717734
+        };
+        static constexpr uint32_t kLimit = 693147;
+
+        uint64_t total = 0;
+        uint64_t busy = 0;
+
+        for (std::size_t i = 0; i < inCount; i++) {
+
+            const auto period = inEntries[i].task->getPeriod();
+
+            if (period == 0 || inEntries[i].wcet > period) {
+                return false;
+            }
+
+            total += ppm(inEntries[i].wcet, period);
+            busy += inEntries[i].wcet;
+        }
+
+        if (total > 1000000) {
+            // overloaded whatever the priorities
+            return false;
+        }
+
+        if (mAnalysis == Analysis::ReleaseOrder) {
+
+            // a job released just after every other task completes
+            // after all of them, within its period
+            for (std::size_t i = 0; i < inCount; i++) {
+                if (busy > inEntries[i].task->getPeriod()) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        for (std::size_t i = 0; i < inCount; i++) {
+
+            const auto period = inEntries[i].task->getPeriod();
+            const auto wcet = inEntries[i].wcet;
+
+            // a job of a longer period task may be running at the release,
+            // tasks of the same period interfere like higher priority ones
+            tick_t blocking = 0;
+            uint64_t load = ppm(wcet, period);
+            std::size_t rank = 1;
+
+            for (std::size_t j = 0; j < inCount; j++) {
+
+                if (j == i) {
+                    continue;
+                }
+
+                const auto otherPeriod = inEntries[j].task->getPeriod();
+
+                if (otherPeriod > period) {
+                    if (inEntries[j].wcet > blocking) {
+                        blocking = inEntries[j].wcet;
+                    }
+                }
+                else {
+                    load += ppm(inEntries[j].wcet, otherPeriod);
+                    rank++;
+                }
+            }
+
+            if (mAnalysis == Analysis::UtilizationBound) {
+
+                const uint32_t bound = (rank <= sizeof(kBounds) / sizeof(kBounds[0])) ? kBounds[rank - 1] : kLimit;
+
+                if (load + ppm(blocking, period) > bound) {
+                    return false;
+                }
+
+                continue;
+            }
+
+            // start time of the job, each higher priority task released
+            // up to the start takes the processor first
+            uint64_t start = 0;
+
+            for (;;) {
+
+                uint64_t next = blocking;
+
+                for (std::size_t j = 0; j < inCount; j++) {
+
+                    const auto otherPeriod = inEntries[j].task->getPeriod();
+
+                    if (j != i && otherPeriod <= period) {
+                        next += (start / otherPeriod + 1) * inEntries[j].wcet;
+                    }
+                }
+
+                if (next + wcet > period) {
+                    return false;
+                }
+
+                if (next == start) {
+                    break;
+                }
+
+                start = next;
+            }
+        }
+
+        return true;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/ischeduler.hpp"
+#include "ucosm/core/level_queue.hpp"
+#include "ipriority_task.hpp"
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Fixed priority scheduler.
+     * The highest priority ready task runs, the tasks of a level take
+     * turns. Dispatch is O(1) whatever the number of tasks (see LevelQueue).
+     * Priorities beyond the last level share the last one.
+     *
+     * @tparam level_count Number of priority levels, up to 64.
+     * @tparam sched_task_t Scheduler task type
+     * @tparam stats_t Statistics policy (NoStats, StatsTable<N>), durations
+     * are measured with the clock given to the constructor.
+     */
+    template<
+        std::size_t level_count = 32,
+        typename sched_task_t = ITask<int8_t>,
+        typename stats_t = NoStats
+    >
+    struct PriorityScheduler : IScheduler<
+        IPriorityTask,
+        sched_task_t,
+        FixedLevelQueue<level_count>::template type,
+        stats_t
+    > {
+
+        using get_tick_t = TaskStats::tick_t(*)();
+
+        /**
+         * @brief Construct a new priority scheduler without a clock.
+         * Not available with a statistics policy, which needs the clock.
+         *
+         * @param inIdleTask Function to execute when there is no task to run.
+         */
+        PriorityScheduler(idle_task_t inIdleTask = nullptr) :
+            base_t(inIdleTask) {
+            static_assert(!stats_t::enabled, "the statistics policy requires a clock");
+        }
+
+        /**
+         * @brief Construct a new priority scheduler with a clock.
+         *
+         * @param inGetTick Clock, only used by the statistics policy.
+         * @param inIdleTask Function to execute when there is no task to run.
+         */
+        PriorityScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
+            base_t(inIdleTask),
+            mGetTick(inGetTick) {}
+
+        /**
+         * @brief Adds a task at the back of its priority level.
+         *
+         * @param inTask Task instance.
+         * @return true if the task was successfully added.
+         * @return false otherwise.
+         */
+        bool addTask(IPriorityTask& inTask) override;
+
+        template<typename iterator_t, typename mask_iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast, mask_iterator_t outMask) {
+            // each task goes to its own level
+            std::size_t count = 0;
+            for (; inFirst != inLast; ++inFirst, ++outMask) {
+                const bool added = this->addTask(toTask(*inFirst));
+                *outMask = added;
+                count += added;
+            }
+            return count;
+        }
+
+        template<typename iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast) {
+            std::size_t count = 0;
+            for (; inFirst != inLast; ++inFirst) {
+                count += this->addTask(toTask(*inFirst));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Runs the first task of the highest priority level, then
+         * moves it to the back of its level.
+         */
+        void run() override;
+
+        // resumed tasks would be pushed at the cursor level
+        void park(IPriorityTask& inTask) = delete;
+        void resume(IPriorityTask& inTask) = delete;
+
+    private:
+
+        using base_t = IScheduler<
+            IPriorityTask,
+            sched_task_t,
+            FixedLevelQueue<level_count>::template type,
+            stats_t
+        >;
+
+        static IPriorityTask& toTask(IPriorityTask& inTask) { return inTask; }
+        static IPriorityTask& toTask(IPriorityTask* inTask) { return *inTask; }
+
+        get_tick_t mGetTick = nullptr;
+
+    };
+
+    template<std::size_t level_count, typename sched_task_t, typename stats_t>
+    bool PriorityScheduler<level_count, sched_task_t, stats_t>::addTask(IPriorityTask& inTask) {
+
+        if (!base_t::addTask(inTask)) {
+            return false;
+        }
+
+        inTask.setRank(inTask.getPriority());
+        this->sortTask(inTask);
+        return true;
+    }
+
+    template<std::size_t level_count, typename sched_task_t, typename stats_t>
+    void PriorityScheduler<level_count, sched_task_t, stats_t>::run() {
+
+        this->drainInbox();
+
+        this->mCurrentTask = this->getNextTask();
+
+        if (!this->mCurrentTask) {
+            // no task to run
+            this->idle();
+            return;
+        }
+
+        this->trace(TraceEvent::TaskStart, this->mCurrentTask);
+
+        if (stats_t::enabled && mGetTick) {
+            // ranks are levels, not due times
+            const auto start = mGetTick();
+            this->mCurrentTask->run();
+            this->recordRun(*this->mCurrentTask, mGetTick() - start, 0);
+        }
+        else {
+            this->mCurrentTask->run();
+        }
+
+        this->trace(TraceEvent::TaskStop, this->mCurrentTask);
+
+        // Check if task is still linked after execution
+        if (this->mCurrentTask->isLinked()) {
+
+            // back of its level, the priority may have changed
+            this->mCurrentTask->setRank(this->mCurrentTask->getPriority());
+            this->sortTask(*this->mCurrentTask);
+        }
+        else {
+            this->recordRemove(*this->mCurrentTask);
+        }
+
+        this->mCurrentTask = nullptr;
+    }
+
+}
\ No newline at end of file
@@ -60,6 +60,25 @@
 
 
 
+// parks the task outside the ready queue until the waiter is notified,
+// the condition is checked again on each wake-up
+#define UCOSM_WAIT_UNTIL(condition, waiter)                 \
+            this->setPeriod(0);                             \
+            this->mLine = __LINE__;                         \
+        }                                                   \
+        [[fallthrough]];                                    \
+        case __LINE__: {                                    \
+            if (!(condition)) {                             \
+                (waiter).park();                            \
+                if (condition) {                            \
+                    /* event sent while parking */          \
+                    (waiter).cancel();                      \
+                }                                           \
+                return;                                     \
+            }
+
+
+
 #define UCOSM_RESTART                                       \
             this->mLine = init_task_state;                  \
             return;               
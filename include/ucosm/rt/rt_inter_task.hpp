@@ -31,6 +31,7 @@
 #include <stddef.h>
 #include <atomic>
 #include <type_traits>
+#include "ucosm/core/iwakeup.hpp"
 
 namespace ucosm {
 
@@ -86,6 +87,11 @@ namespace ucosm {
 
             // Publish the write
             mWriteIndex.store(nextWrite, std::memory_order_release);
+
+            // Wake up the consumer
+            if (auto* wakeup = mWakeup.load(std::memory_order_acquire)) {
+                wakeup->notify();
+            }
             return true;
         }
 
@@ -146,11 +152,20 @@ namespace ucosm {
                 std::memory_order_release);
         }
 
+        /**
+         * @brief Set the wake-up notified on each sent message.
+         * @param wakeup Wake-up of the consumer (e.g. TaskWaiter), nullptr to remove it
+         */
+        void setWakeup(IWakeup* wakeup) {
+            mWakeup.store(wakeup, std::memory_order_release);
+        }
+
     private:
         // Platform-optimized alignment to prevent false sharing
         alignas(std::max_align_t) std::atomic<size_t> mReadIndex;
         alignas(std::max_align_t) std::atomic<size_t> mWriteIndex;
         alignas(std::max_align_t) T mBuffer[Size];
+        std::atomic<IWakeup*> mWakeup { nullptr };
     };
 
     /**
@@ -278,6 +293,23 @@ namespace ucosm {
          */
         void setFlags(flags_t flags) {
             mFlags.fetch_or(flags, std::memory_order_release);
+
+            // Wake up the waiter if it waits for one of the flags
+            if (flags & mWakeMask.load(std::memory_order_relaxed)) {
+                if (auto* wakeup = mWakeup.load(std::memory_order_acquire)) {
+                    wakeup->notify();
+                }
+            }
+        }
+
+        /**
+         * @brief Set the wake-up notified when flags of a mask are set.
+         * @param wakeup Wake-up of the waiter (e.g. TaskWaiter), nullptr to remove it
+         * @param mask Flags that trigger the notification
+         */
+        void setWakeup(IWakeup* wakeup, flags_t mask) {
+            mWakeMask.store(mask, std::memory_order_relaxed);
+            mWakeup.store(wakeup, std::memory_order_release);
         }
 
         /**
@@ -372,6 +404,8 @@ namespace ucosm {
 
     private:
         std::atomic<flags_t> mFlags;
+        std::atomic<flags_t> mWakeMask { 0 };
+        std::atomic<IWakeup*> mWakeup { nullptr };
     };
 
 }
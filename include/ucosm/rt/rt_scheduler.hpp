@@ -28,6 +28,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <cstddef>
 #include "irt_timer.hpp"
 #include "ucosm/core/ischeduler.hpp"
 #include "ucosm/periodic/iperiodic_task.hpp"
@@ -36,11 +37,27 @@ namespace ucosm {
 
     /**
      * @brief Real-time scheduler.
+     *
+     * @tparam stats_t Statistics policy (NoStats, StatsTable<N>), durations
+     * and lateness are measured with the clock given to the constructor.
      */
-    struct RTScheduler : IScheduler<IPeriodicTask, ITask<uint8_t>> {
+    template<typename stats_t = NoStats>
+    struct BasicRTScheduler : IScheduler<IPeriodicTask, ITask<uint8_t>, SortedList, stats_t> {
 
         using ITimer = IRTTimer<ITask<uint8_t>>;
 
+        using get_tick_t = IPeriodicTask::tick_t(*)();
+
+        /**
+         * @brief Construct a new real-time scheduler.
+         *
+         * @param inGetTick Clock in timer units, only used by the statistics
+         * policy and the deadline checks.
+         */
+        BasicRTScheduler(get_tick_t inGetTick = nullptr) {
+            mClock.mGetTick = inGetTick;
+        }
+
         bool setTimer(ITimer& inTimer) {
             if (mTimer || !inTimer.setTask(*this)) {
                 // scheduler already has a timer
@@ -79,19 +96,61 @@ namespace ucosm {
             }
 
             if (inDelay) {
-                inTask.setRank(this->mCursorTask.getRank() + inDelay);
+                inTask.setRank(this->mTasks.getCursor() + inDelay);
                 this->sortTask(inTask);
             }
 
             if (!mTimer->isRunning()) {
                 mTimer->setDuration(inDelay);
+                setDue(inDelay);
+                if (mClock.mGetTick) {
+                    // the timer counts from now
+                    mClock.mExpiry = mClock.mGetTick();
+                }
+                this->trace(TraceEvent::TimerSet, nullptr, inDelay);
                 mTimer->start();
             }
 
             return true;
         }
 
-        ~RTScheduler() {
+        template<typename iterator_t, typename mask_iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast, mask_iterator_t outMask) {
+            // each task goes through the period and timer checks
+            std::size_t count = 0;
+            for (; inFirst != inLast; ++inFirst, ++outMask) {
+                const bool added = this->addTask(toTask(*inFirst));
+                *outMask = added;
+                count += added;
+            }
+            return count;
+        }
+
+        template<typename iterator_t>
+        std::size_t addTasks(iterator_t inFirst, iterator_t inLast) {
+            std::size_t count = 0;
+            for (; inFirst != inLast; ++inFirst) {
+                count += this->addTask(toTask(*inFirst));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns the number of deadline misses of every task,
+         * see IPeriodicTask::setDeadline(). Requires a clock.
+         *
+         * @return std::size_t Deadline miss count.
+         */
+        std::size_t deadlineMisses() const { return mDeadlineMisses; }
+
+        // the timer context doesn't drain posted tasks, use addTask()
+        void post(IPeriodicTask& inTask) = delete;
+
+        // nor resumed tasks, parking isn't supported
+        void park(IPeriodicTask& inTask) = delete;
+        void resume(IPeriodicTask& inTask) = delete;
+
+        ~BasicRTScheduler() {
             if (mTimer) {
                 mTimer->stop();
                 mTimer->removeTask();
@@ -102,7 +161,21 @@ namespace ucosm {
 
         void delay(uint32_t inDelay) {
             mTimer->setDuration(inDelay);
+            setDue(inDelay);
+            this->trace(TraceEvent::TimerSet, nullptr, inDelay);
             mCounter += inDelay;
+            mClock.mExpiry += inDelay;
+        }
+
+        void stopTimer() {
+            mTimer->stop();
+            this->trace(TraceEvent::TimerStop);
+        }
+
+        void setDue(uint32_t inDelay) {
+            if (mClock.mGetTick) {
+                mClock.mDue = mClock.mGetTick() + inDelay;
+            }
         }
 
         void run() override {
@@ -112,12 +185,12 @@ namespace ucosm {
             if (!this->mCurrentTask) {
                 // no task to execute
                 // scheduler is empty
-                mTimer->stop();
+                stopTimer();
                 return;
             }
 
             // check if the task to be executed hasn't been deleted since the timer has been programed
-            const auto cursorRank = this->mCursorTask.getRank();
+            const auto cursorRank = this->mTasks.getCursor();
             const auto currentRank = this->mCurrentTask->getRank();
 
             const auto deltaTask = currentRank - cursorRank;
@@ -132,7 +205,7 @@ namespace ucosm {
                 }
                 else {
                     // no other task to execute
-                    mTimer->stop();
+                    stopTimer();
                 }
 
                 this->mCurrentTask = nullptr;
@@ -140,35 +213,76 @@ namespace ucosm {
             }
 
             // execute the task
-            this->mCursorTask.setRank(currentRank);
-            this->mCurrentTask->run();
+            this->mTasks.setCursor(currentRank);
+            this->trace(TraceEvent::TaskStart, this->mCurrentTask);
+
+            if (mClock.mGetTick && (stats_t::enabled || this->mCurrentTask->getDeadline())) {
+                const uint32_t start = mClock.mGetTick();
+                this->mCurrentTask->run();
+                const uint32_t duration = mClock.mGetTick() - start;
+                this->recordRun(*this->mCurrentTask, duration, start - mClock.mDue);
+
+                // release tick of the task, the timer expiry matches the counter
+                const uint32_t release = mClock.mExpiry - (mCounter - currentRank);
+                const uint32_t lateness = (static_cast<int32_t>(start - release) > 0) ? (start - release) : 0;
+
+                if (const auto misses = this->mCurrentTask->checkDeadline(lateness, duration)) {
+                    mDeadlineMisses += misses;
+                    this->trace(TraceEvent::DeadlineMiss, this->mCurrentTask, misses);
+                }
+            }
+            else {
+                this->mCurrentTask->run();
+            }
+
+            this->trace(TraceEvent::TaskStop, this->mCurrentTask);
 
             // Check if task is still linked after execution
             if (this->mCurrentTask->isLinked()) {
 
                 // the task is still in the list
-                // update the task rank
+                // update the task rank, the counter is the dispatch tick
                 this->mCurrentTask->setRank(
-                    currentRank +
-                    this->mCurrentTask->getPeriod()
+                    this->mCurrentTask->nextRelease(currentRank, mCounter)
                 );
 
                 this->sortTask(*this->mCurrentTask);
             }
-            else if (this->empty()) {
-                mTimer->stop();
-                this->mCurrentTask = nullptr;
-                return;
+            else {
+
+                this->recordRemove(*this->mCurrentTask);
+
+                if (this->empty()) {
+                    stopTimer();
+                    this->mCurrentTask = nullptr;
+                    return;
+                }
             }
 
-            delay(this->getNextRank() - currentRank);
+            // a release behind the counter fires at once
+            const uint32_t nextDelay = this->getNextRank() - mCounter;
+            delay(static_cast<int32_t>(nextDelay) > 0 ? nextDelay : 0);
             this->mCurrentTask = nullptr;
         }
 
 
+        static IPeriodicTask& toTask(IPeriodicTask& inTask) { return inTask; }
+        static IPeriodicTask& toTask(IPeriodicTask* inTask) { return *inTask; }
+
+        struct Clock {
+            get_tick_t mGetTick = nullptr;
+            uint32_t mDue = 0;
+            // expiry of a compare timer, moved forward by each duration
+            uint32_t mExpiry = 0;
+        };
+
         uint32_t mCounter = 0;
-        using base_t = IScheduler<IPeriodicTask, ITask<uint8_t>>;
+        Clock mClock;
+        std::size_t mDeadlineMisses = 0;
+        using base_t = IScheduler<IPeriodicTask, ITask<uint8_t>, SortedList, stats_t>;
         ITimer* mTimer = nullptr;
     };
 
+    using RTScheduler = BasicRTScheduler<>;
+
 }
\ No newline at end of file
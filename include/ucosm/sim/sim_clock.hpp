@@ -0,0 +1,81 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Virtual clock for deterministic tests and benchmarks.
+     *
+     * The time only moves when set() or advance() are called, by the test
+     * or by simulated work in a task. now() is a plain function so it can
+     * be given to any scheduler as get_tick_t. The state is static, a
+     * different tag type gives an independent clock.
+     *
+     * @code
+     * using clock_t = ucosm::SimClock<>;
+     * ucosm::PeriodicScheduler<> sched(clock_t::now);
+     * @endcode
+     *
+     * @tparam tag_t Clock identity.
+     */
+    template<typename tag_t = void>
+    struct SimClock {
+
+        using tick_t = uint32_t;
+
+        /**
+         * @brief Returns the current virtual time.
+         *
+         * @return tick_t Current tick.
+         */
+        static tick_t now() { return sNow; }
+
+        /**
+         * @brief Sets the virtual time.
+         *
+         * @param inTick New tick.
+         */
+        static void set(tick_t inTick) { sNow = inTick; }
+
+        /**
+         * @brief Moves the virtual time forward.
+         *
+         * @param inTicks Number of ticks.
+         */
+        static void advance(tick_t inTicks) { sNow += inTicks; }
+
+    private:
+
+        static inline tick_t sNow = 0;
+
+    };
+
+}
@@ -0,0 +1,153 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/rt/irt_timer.hpp"
+#include "ucosm/core/itask.hpp"
+#include "sim_clock.hpp"
+#include <stdint.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Real-time timer driven by a virtual clock.
+     *
+     * Behaves like a free running compare timer: start() arms it at the
+     * current time, each setDuration() moves the deadline forward from
+     * the previous one, so the periods don't drift with the execution
+     * time. Nothing fires on its own: step(), runFor() and runUntil()
+     * move the clock straight to the next deadline and run the task, so
+     * hours of scheduling replay in milliseconds.
+     *
+     * @tparam clock_t Clock type providing now() and set() (SimClock).
+     * @tparam task_t Task type run by the timer.
+     */
+    template<typename clock_t = SimClock<>, typename task_t = ITask<uint8_t>>
+    struct SimRTTimer : IRTTimer<task_t> {
+
+        using tick_t = uint32_t;
+
+        void start() override {
+            mDeadline = clock_t::now();
+            mRunning = true;
+        }
+
+        void stop() override { mRunning = false; }
+
+        bool isRunning() const override { return mRunning; }
+
+        void setDuration(uint32_t inDuration) override { mDeadline += inDuration; }
+
+        void disable() override { mEnabled = false; }
+
+        void enable() override { mEnabled = true; }
+
+        /**
+         * @brief Tells if the timer will fire.
+         *
+         * @return true if the timer is running and enabled.
+         * @return false otherwise.
+         */
+        bool isArmed() const { return mRunning && mEnabled; }
+
+        /**
+         * @brief Returns the time of the next expiry.
+         *
+         * @return tick_t Deadline tick.
+         */
+        tick_t getDeadline() const { return mDeadline; }
+
+        /**
+         * @brief Moves the clock to the next deadline and runs the task.
+         * A deadline in the past fires without moving the clock.
+         *
+         * @return true if the timer fired.
+         * @return false if the timer isn't armed.
+         */
+        bool step();
+
+        /**
+         * @brief Fires every expiry up to a given tick, then moves the clock to it.
+         *
+         * @param inTick Tick to reach.
+         * @return std::size_t Number of expiries.
+         */
+        std::size_t runUntil(tick_t inTick);
+
+        /**
+         * @brief Fires every expiry during a given duration.
+         *
+         * @param inDuration Number of ticks.
+         * @return std::size_t Number of expiries.
+         */
+        std::size_t runFor(tick_t inDuration) { return runUntil(clock_t::now() + inDuration); }
+
+    private:
+
+        tick_t mDeadline = 0;
+        bool mRunning = false;
+        bool mEnabled = true;
+
+    };
+
+    template<typename clock_t, typename task_t>
+    bool SimRTTimer<clock_t, task_t>::step() {
+
+        if (!isArmed()) {
+            return false;
+        }
+
+        const tick_t now = clock_t::now();
+
+        // wrap safe, a late deadline is within half the tick range behind
+        if (static_cast<int32_t>(mDeadline - now) > 0) {
+            clock_t::set(mDeadline);
+        }
+
+        this->run();
+        return true;
+    }
+
+    template<typename clock_t, typename task_t>
+    std::size_t SimRTTimer<clock_t, task_t>::runUntil(tick_t inTick) {
+
+        std::size_t count = 0;
+
+        while (isArmed() && static_cast<int32_t>(inTick - mDeadline) >= 0) {
+            step();
+            count++;
+        }
+
+        if (static_cast<int32_t>(inTick - clock_t::now()) > 0) {
+            clock_t::set(inTick);
+        }
+
+        return count;
+    }
+
+}
@@ -0,0 +1,200 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/ischeduler.hpp"
+#include "static_periodic_task.hpp"
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Statically dispatched periodic scheduler.
+     *
+     * Schedules tasks of a single type with the PeriodicScheduler rules.
+     * Task functions are called without virtual dispatch when task_t::run()
+     * is not virtual, a virtual run() in task_t allows different task
+     * classes at the cost of one virtual call per run.
+     * The task list is kept sorted relative to the last executed rank.
+     *
+     * @tparam task_t Task type, derived from StaticPeriodicTask.
+     * @tparam sched_task_t Scheduler task type
+     */
+    template<typename task_t, typename sched_task_t = ITask<int8_t>>
+    struct StaticPeriodicScheduler : sched_task_t {
+
+        using tick_t = typename task_t::tick_t;
+
+        using get_tick_t = tick_t(*)();
+
+        StaticPeriodicScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
+            mGetTick(inGetTick),
+            mIdleTask(inIdleTask) {}
+
+        /**
+         * @brief Adds a task to the scheduler.
+         *
+         * @param inTask Task instance.
+         * @return true if the task was successfully added.
+         * @return false otherwise.
+         */
+        bool addTask(task_t& inTask);
+
+        /**
+         * @brief Delay the task.
+         *
+         * @param inDelay Delay value.
+         */
+        void setDelay(task_t& inTask, tick_t inDelay);
+
+        /**
+         * @brief Runs the next ready tasks.
+         */
+        void run() override;
+
+        /**
+         * @brief Returns the currently executed task.
+         *
+         * @return task_t* Pointer to the task.
+         */
+        task_t* thisTask() { return mCurrentTask; }
+
+        std::size_t size() const { return mTasks.size(); }
+
+        bool empty() const { return mTasks.empty(); }
+
+        void clear() { mTasks.clear(); }
+
+        void setIdleTask(idle_task_t inIdleTask) { mIdleTask = inIdleTask; }
+
+    private:
+
+        void insert(task_t& inTask);
+
+        ulink::List<task_t> mTasks;
+
+        tick_t mCursor = 0;
+
+        get_tick_t mGetTick;
+
+        idle_task_t mIdleTask;
+
+        task_t* mCurrentTask = nullptr;
+
+    };
+
+    template<typename task_t, typename sched_task_t>
+    bool StaticPeriodicScheduler<task_t, sched_task_t>::addTask(task_t& inTask) {
+
+        if (inTask.isLinked() || !inTask.init()) {
+            return false;
+        }
+
+        inTask.setRank(mCursor);
+        insert(inTask);
+        return true;
+    }
+
+    template<typename task_t, typename sched_task_t>
+    void StaticPeriodicScheduler<task_t, sched_task_t>::setDelay(
+        task_t& inTask,
+        tick_t inDelay
+    ) {
+        inTask.setRank(mGetTick() + inDelay);
+        if (inTask.isLinked()) {
+            insert(inTask);
+        }
+    }
+
+    template<typename task_t, typename sched_task_t>
+    void StaticPeriodicScheduler<task_t, sched_task_t>::run() {
+
+        if (mTasks.empty()) {
+            if (mIdleTask) {
+                mIdleTask();
+            }
+            return;
+        }
+
+        auto& task = mTasks.front();
+
+        const tick_t tick = mGetTick();
+        const tick_t deltaTask = task.getRank() - mCursor;
+        const tick_t deltaTick = tick - mCursor;
+
+        if (deltaTick < deltaTask) {
+            // task is not ready
+            if (mIdleTask) {
+                mIdleTask();
+            }
+            return;
+        }
+
+        mCurrentTask = &task;
+        mCursor = task.getRank();
+        task.run();
+
+        // Check if task is still linked after execution
+        if (task.isLinked()) {
+            task.setRank(tick + task.getPeriod());
+            insert(task);
+        }
+
+        mCurrentTask = nullptr;
+    }
+
+    template<typename task_t, typename sched_task_t>
+    void StaticPeriodicScheduler<task_t, sched_task_t>::insert(task_t& inTask) {
+
+        inTask.ulink::Node<task_t>::remove();
+
+        if (mTasks.empty()) {
+            mTasks.push_back(inTask);
+            return;
+        }
+
+        // ranks are compared relative to the cursor to handle overflows
+        const tick_t delta = inTask.getRank() - mCursor;
+
+        // walk from the back, equal ranks keep their insertion order
+        task_t* pos = &mTasks.back();
+
+        while (static_cast<tick_t>(pos->getRank() - mCursor) > delta) {
+
+            if (pos == &mTasks.front()) {
+                mTasks.push_front(inTask);
+                return;
+            }
+
+            pos = pos->prev;
+        }
+
+        mTasks.insert_after(pos, inTask);
+    }
+
+}
@@ -0,0 +1,68 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "static_task.hpp"
+#include <stdint.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Statically dispatched periodic task.
+     *
+     * @tparam derived_t Derived task type.
+     */
+    template<typename derived_t>
+    struct StaticPeriodicTask : StaticTask<derived_t, uint32_t> {
+
+        using tick_t = uint32_t;
+
+        StaticPeriodicTask(tick_t inPeriod = 0) :
+            mPeriod(inPeriod) {}
+
+        /**
+         * @brief Set the task period.
+         *
+         * @param inPeriod Period value.
+         */
+        void setPeriod(tick_t inPeriod) { mPeriod = inPeriod; }
+
+        /**
+         * @brief Get the task period.
+         *
+         * @return tick_t Period  value.
+         */
+        tick_t getPeriod() const { return mPeriod; }
+
+    private:
+
+        tick_t mPeriod;
+
+    };
+
+}
@@ -0,0 +1,299 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/ischeduler.hpp"
+#include "ucosm/periodic/iperiodic_task.hpp"
+#include "ucosm/cfs/icfs_task.hpp"
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+namespace ucosm {
+
+    /**
+     * @brief Scheduler over a task set known at compile time.
+     *
+     * Tasks are stored by value in a tuple and their ranks in a fixed array.
+     * Tasks run with the PeriodicScheduler rules if they all derive from
+     * IPeriodicTask, or with the CFSScheduler rules if they all derive from
+     * ICFSTask. Task functions are called without virtual dispatch.
+     * A task calling removeTask() is disabled until added again.
+     *
+     * @tparam sched_task_t Scheduler task type
+     * @tparam tasks_t Task types.
+     */
+    template<typename sched_task_t, typename ... tasks_t>
+    struct BasicStaticScheduler : sched_task_t {
+
+        static_assert(sizeof...(tasks_t) > 0, "empty task set");
+
+        static constexpr bool is_periodic = (std::is_base_of_v<IPeriodicTask, tasks_t> && ...);
+        static constexpr bool is_cfs = (std::is_base_of_v<ICFSTask, tasks_t> && ...);
+
+        static_assert(is_periodic || is_cfs, "tasks must all be periodic or all be CFS tasks");
+
+        static constexpr std::size_t task_count = sizeof...(tasks_t);
+
+        using tick_t = uint32_t;
+
+        using get_tick_t = tick_t(*)();
+
+        BasicStaticScheduler(get_tick_t inGetTick, idle_task_t inIdleTask = nullptr) :
+            mGetTick(inGetTick),
+            mIdleTask(inIdleTask) {}
+
+        /**
+         * @brief Returns a task of the set.
+         *
+         * @tparam I Task index.
+         * @return auto& Task instance.
+         */
+        template<std::size_t I>
+        auto& get() { return std::get<I>(mTasks); }
+
+        /**
+         * @brief Enables a task of the set.
+         *
+         * @tparam I Task index.
+         * @return true if the task was successfully added.
+         * @return false otherwise.
+         */
+        template<std::size_t I>
+        bool addTask();
+
+        /**
+         * @brief Enables every task of the set.
+         *
+         * @return std::size_t Number of added tasks.
+         */
+        std::size_t addTasks();
+
+        /**
+         * @brief Delay a periodic task.
+         *
+         * @tparam I Task index.
+         * @param inDelay Delay value.
+         */
+        template<std::size_t I>
+        void setDelay(tick_t inDelay);
+
+        /**
+         * @brief Runs the next ready task.
+         */
+        void run() override;
+
+        /**
+         * @brief Returns the number of enabled tasks.
+         *
+         * @return std::size_t Number of task.
+         */
+        std::size_t size() const;
+
+        bool empty() const { return size() == 0; }
+
+        void setIdleTask(idle_task_t inIdleTask) { mIdleTask = inIdleTask; }
+
+    private:
+
+        using itask_t = ITask<tick_t>;
+
+        using sequence_t = std::index_sequence_for<tasks_t...>;
+
+        // set as unlink function of enabled tasks
+        static void unlink(itask_t& inTask) { inTask.mUnlink = nullptr; }
+
+        template<std::size_t ... Is>
+        std::size_t addTasks(std::index_sequence<Is...>);
+
+        template<std::size_t ... Is>
+        std::size_t findNext(std::index_sequence<Is...>) const;
+
+        template<std::size_t ... Is>
+        void runTask(std::size_t inIndex, tick_t inTick, std::index_sequence<Is...>);
+
+        template<std::size_t I>
+        void runTask(tick_t inTick);
+
+        std::tuple<tasks_t...> mTasks;
+
+        std::array<tick_t, task_count> mRanks {};
+
+        tick_t mCursor = 0;
+
+        get_tick_t mGetTick;
+
+        idle_task_t mIdleTask;
+
+    };
+
+    /**
+     * @brief Scheduler over a task set known at compile time.
+     *
+     * @tparam tasks_t Task types.
+     */
+    template<typename ... tasks_t>
+    using StaticScheduler = BasicStaticScheduler<ITask<int8_t>, tasks_t...>;
+
+    template<typename sched_task_t, typename ... tasks_t>
+    template<std::size_t I>
+    bool BasicStaticScheduler<sched_task_t, tasks_t...>::addTask() {
+
+        auto& task = std::get<I>(mTasks);
+
+        if (task.isLinked() || !task.init()) {
+            return false;
+        }
+
+        static_cast<itask_t&>(task).mUnlink = &BasicStaticScheduler::unlink;
+        mRanks[I] = mCursor;
+        return true;
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    std::size_t BasicStaticScheduler<sched_task_t, tasks_t...>::addTasks() {
+        return addTasks(sequence_t {});
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    template<std::size_t ... Is>
+    std::size_t BasicStaticScheduler<sched_task_t, tasks_t...>::addTasks(std::index_sequence<Is...>) {
+        return (std::size_t(addTask<Is>()) + ...);
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    template<std::size_t I>
+    void BasicStaticScheduler<sched_task_t, tasks_t...>::setDelay(tick_t inDelay) {
+        static_assert(is_periodic, "only periodic tasks can be delayed");
+        mRanks[I] = mGetTick() + inDelay;
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    void BasicStaticScheduler<sched_task_t, tasks_t...>::run() {
+
+        const auto index = findNext(sequence_t {});
+
+        if (index == task_count) {
+            // no task to run
+            if (mIdleTask) {
+                mIdleTask();
+            }
+            return;
+        }
+
+        const tick_t tick = mGetTick();
+
+        if constexpr (is_periodic) {
+
+            const tick_t deltaTask = mRanks[index] - mCursor;
+            const tick_t deltaTick = tick - mCursor;
+
+            if (deltaTick < deltaTask) {
+                // task is not ready
+                if (mIdleTask) {
+                    mIdleTask();
+                }
+                return;
+            }
+        }
+
+        runTask(index, tick, sequence_t {});
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    std::size_t BasicStaticScheduler<sched_task_t, tasks_t...>::size() const {
+        return std::apply(
+            [] (const auto&... inTasks) {
+                return (std::size_t(inTasks.isLinked()) + ...);
+            },
+            mTasks
+        );
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    template<std::size_t ... Is>
+    std::size_t BasicStaticScheduler<sched_task_t, tasks_t...>::findNext(std::index_sequence<Is...>) const {
+
+        std::size_t next = task_count;
+        tick_t lowest = 0;
+
+        auto check = [&] (std::size_t inIndex, bool inLinked) {
+            // ranks are compared relative to the cursor to handle overflows
+            const tick_t delta = mRanks[inIndex] - mCursor;
+            if (inLinked && (next == task_count || delta < lowest)) {
+                next = inIndex;
+                lowest = delta;
+            }
+        };
+
+        (check(Is, std::get<Is>(mTasks).isLinked()), ...);
+
+        return next;
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    template<std::size_t ... Is>
+    void BasicStaticScheduler<sched_task_t, tasks_t...>::runTask(
+        std::size_t inIndex,
+        tick_t inTick,
+        std::index_sequence<Is...>
+    ) {
+        ((inIndex == Is ? runTask<Is>(inTick) : void()), ...);
+    }
+
+    template<typename sched_task_t, typename ... tasks_t>
+    template<std::size_t I>
+    void BasicStaticScheduler<sched_task_t, tasks_t...>::runTask(tick_t inTick) {
+
+        using task_t = std::tuple_element_t<I, std::tuple<tasks_t...>>;
+
+        auto& task = std::get<I>(mTasks);
+
+        mCursor = mRanks[I];
+
+        // qualified call, no virtual dispatch
+        task.task_t::run();
+
+        // Check if task is still linked after execution
+        if (!task.isLinked()) {
+            return;
+        }
+
+        if constexpr (is_periodic) {
+            mRanks[I] = task.nextRelease(mCursor, inTick);
+        }
+        else {
+            tick_t taskDuration = mGetTick() - inTick;
+            taskDuration <<= task.getPriority();
+            mRanks[I] = mCursor + taskDuration;
+        }
+    }
+
+}
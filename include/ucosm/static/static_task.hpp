@@ -0,0 +1,140 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ulink.hpp"
+#include <string_view>
+
+namespace ucosm {
+
+    template<typename task_t, typename sched_task_t>
+    struct StaticPeriodicScheduler;
+
+    /**
+     * @brief Statically dispatched task interface.
+     *
+     * Same intrusive semantics as ITask without virtual functions:
+     * the scheduler calls the derived class run(), init(), deinit()
+     * and name() directly. The hooks below are defaults hidden by the
+     * derived class.
+     *
+     * @tparam derived_t Derived task type.
+     * @tparam rank_t Type used to sort tasks execution.
+     */
+    template<typename derived_t, typename _rank_t>
+    struct StaticTask : ulink::Node<derived_t> {
+
+        using rank_t = _rank_t;
+
+        /**
+         * @brief Initializes the task.
+         * Called by the scheduler when the task is added.
+         *
+         * @return true if the task was successfully initialized.
+         * @return false otherwise.
+         */
+        bool init() { return true; }
+
+        /**
+         * @brief Deinitializes the task.
+         * Called when the task is removed.
+         */
+        void deinit() {}
+
+        /**
+         * @brief Returns the name of the task.
+         *
+         * @return std::string_view Task name.
+         */
+        std::string_view name() { return ""; }
+
+        /**
+         * @brief Removes the task from the scheduler.
+         */
+        void removeTask();
+
+        /**
+         * @brief Tells if the task is held by a scheduler.
+         *
+         * @return true if the task is linked.
+         * @return false otherwise.
+         */
+        bool isLinked() const;
+
+        /**
+         * @brief Sets the task rank value.
+         *
+         * @param inRank inRank New rank value.
+         */
+        void setRank(rank_t inRank);
+
+        /**
+         * @brief Gets the task rank value.
+         *
+         * @return rank_t Rank value.
+         */
+        rank_t getRank() const;
+
+    private:
+
+        template<typename T>
+        friend class ulink::List;
+
+        template<typename task_t, typename sched_task_t>
+        friend struct StaticPeriodicScheduler;
+
+        using ulink::Node<derived_t>::remove;
+
+        rank_t mRank = rank_t();
+
+    };
+
+    template<typename derived_t, typename rank_t>
+    void StaticTask<derived_t, rank_t>::removeTask() {
+        if (this->isLinked()) {
+            static_cast<derived_t*>(this)->deinit();
+        }
+        ulink::Node<derived_t>::remove();
+    }
+
+    template<typename derived_t, typename rank_t>
+    bool StaticTask<derived_t, rank_t>::isLinked() const {
+        return ulink::Node<derived_t>::isLinked();
+    }
+
+    template<typename derived_t, typename rank_t>
+    void StaticTask<derived_t, rank_t>::setRank(rank_t inRank) {
+        mRank = inRank;
+    }
+
+    template<typename derived_t, typename rank_t>
+    rank_t StaticTask<derived_t, rank_t>::getRank() const {
+        return mRank;
+    }
+
+}
@@ -0,0 +1,234 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/trace_ring.hpp"
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <stdint.h>
+#include <cstddef>
+
+namespace ucosm {
+
+    /**
+     * @brief Writes the records of a trace ring as Chrome trace_event JSON,
+     * loadable in Perfetto or chrome://tracing.
+     *
+     * Task runs are duration events, adds, removals and idle entries are
+     * instant events and timer durations are a counter track. Timestamps
+     * start at the oldest record. Nothing is allocated: the stream only
+     * needs an operator<< taking a std::string_view. A stream exposing
+     * overflow() (MappedFileStream) or fail() (std::ostream) is checked
+     * once the trace is written.
+     *
+     * @tparam stream_t Stream type.
+     * @param inRing Trace ring.
+     * @param inStream Stream instance.
+     * @param inMicrosPerTick Duration of a tick in microseconds.
+     * @param inThreadID Thread id of the events in the trace.
+     * @return std::size_t Number of exported records, 0 if the stream failed.
+     */
+    template<typename stream_t>
+    std::size_t writeChromeTrace(
+        const TraceRing& inRing,
+        stream_t&& inStream,
+        uint32_t inMicrosPerTick = 1,
+        uint32_t inThreadID = 0
+    );
+
+    namespace chrome_trace {
+
+        template<typename stream_t, typename = void>
+        struct HasOverflow : std::false_type {};
+
+        template<typename stream_t>
+        struct HasOverflow<stream_t, std::void_t<decltype(std::declval<const stream_t&>().overflow())>> :
+            std::true_type {};
+
+        template<typename stream_t, typename = void>
+        struct HasFail : std::false_type {};
+
+        template<typename stream_t>
+        struct HasFail<stream_t, std::void_t<decltype(std::declval<const stream_t&>().fail())>> :
+            std::true_type {};
+
+        template<typename stream_t>
+        bool failed(const stream_t& inStream) {
+            if constexpr (HasOverflow<stream_t>::value) {
+                return inStream.overflow();
+            }
+            else if constexpr (HasFail<stream_t>::value) {
+                return inStream.fail();
+            }
+            else {
+                return false;
+            }
+        }
+
+        template<typename stream_t>
+        void writeNumber(stream_t& inStream, uint64_t inValue) {
+            char buffer[24];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), inValue);
+            inStream << std::string_view(buffer, result.ptr - buffer);
+        }
+
+        template<typename stream_t>
+        void writeString(stream_t& inStream, std::string_view inString) {
+
+            inStream << std::string_view("\"");
+
+            std::size_t begin = 0;
+
+            for (std::size_t i = 0; i < inString.size(); i++) {
+
+                const char c = inString[i];
+
+                if (c != '"' && c != '\\' && static_cast<unsigned char>(c) >= 0x20) {
+                    continue;
+                }
+
+                inStream << inString.substr(begin, i - begin);
+
+                if (c == '"' || c == '\\') {
+                    const char escaped[2] = { '\\', c };
+                    inStream << std::string_view(escaped, 2);
+                }
+                else {
+                    // control characters are replaced
+                    inStream << std::string_view(" ");
+                }
+
+                begin = i + 1;
+            }
+
+            inStream << inString.substr(begin) << std::string_view("\"");
+        }
+
+    }
+
+    template<typename stream_t>
+    std::size_t writeChromeTrace(
+        const TraceRing& inRing,
+        stream_t&& inStream,
+        uint32_t inMicrosPerTick,
+        uint32_t inThreadID
+    ) {
+
+        using namespace chrome_trace;
+
+        bool first = true;
+        uint32_t lastTick = 0;
+        uint64_t timestamp = 0;
+
+        inStream << std::string_view("{\"traceEvents\":[");
+
+        const auto count = inRing.forEach(
+            [&] (const TraceRecord& r) {
+
+                if (!first) {
+                    // ticks may wrap, only deltas are accumulated
+                    timestamp += uint64_t(uint32_t(r.tick - lastTick)) * inMicrosPerTick;
+                    inStream << std::string_view(",");
+                }
+
+                first = false;
+                lastTick = r.tick;
+
+                std::string_view name = r.name.empty() ? std::string_view("task") : r.name;
+                std::string_view phase = "i";
+                std::string_view category = "scheduler";
+
+                switch (r.event) {
+                    case TraceEvent::TaskStart:
+                        phase = "B";
+                        category = "task";
+                        break;
+                    case TraceEvent::TaskStop:
+                        phase = "E";
+                        category = "task";
+                        break;
+                    case TraceEvent::TaskAdd:
+                        category = "add";
+                        break;
+                    case TraceEvent::TaskRemove:
+                        category = "remove";
+                        break;
+                    case TraceEvent::TaskPark:
+                        category = "park";
+                        break;
+                    case TraceEvent::TaskResume:
+                        category = "resume";
+                        break;
+                    case TraceEvent::Idle:
+                        name = "idle";
+                        break;
+                    case TraceEvent::TimerSet:
+                    case TraceEvent::TimerStop:
+                        name = "timer";
+                        phase = "C";
+                        break;
+                    case TraceEvent::DeadlineMiss:
+                        category = "deadline";
+                        break;
+                }
+
+                inStream << std::string_view("\n{\"name\":");
+                writeString(inStream, name);
+                inStream << std::string_view(",\"cat\":\"") << category;
+                inStream << std::string_view("\",\"ph\":\"") << phase;
+                inStream << std::string_view("\",\"ts\":");
+                writeNumber(inStream, timestamp);
+                inStream << std::string_view(",\"pid\":0,\"tid\":");
+                writeNumber(inStream, inThreadID);
+
+                if (phase == "i") {
+                    inStream << std::string_view(",\"s\":\"t\"");
+                }
+                else if (phase == "C") {
+                    inStream << std::string_view(",\"args\":{\"duration\":");
+                    writeNumber(inStream, (r.event == TraceEvent::TimerSet) ? r.value : 0);
+                    inStream << std::string_view("}");
+                }
+
+                inStream << std::string_view("}");
+            }
+        );
+
+        inStream << std::string_view("\n]}\n");
+
+        if (failed(inStream)) {
+            // the output is truncated
+            return 0;
+        }
+
+        return count;
+    }
+
+}
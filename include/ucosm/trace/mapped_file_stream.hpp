@@ -0,0 +1,144 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "MappedFileStream is only available on POSIX systems"
+#endif
+
+#include <string_view>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Output stream writing into a memory-mapped file.
+     *
+     * The file is created with the given capacity and mapped once, writes
+     * are plain copies into the mapping. Once a write doesn't fit in the
+     * capacity, it and every later write are dropped and overflow() is
+     * set, so the file holds a clean prefix of the output. The file is truncated to the
+     * written size when the stream is closed.
+     */
+    struct MappedFileStream {
+
+        /**
+         * @brief Creates or truncates a file and maps it.
+         *
+         * @param inPath File path.
+         * @param inCapacity Maximum file size.
+         */
+        MappedFileStream(const char* inPath, std::size_t inCapacity);
+
+        MappedFileStream(const MappedFileStream&) = delete;
+        MappedFileStream& operator=(const MappedFileStream&) = delete;
+
+        ~MappedFileStream() { close(); }
+
+        MappedFileStream& operator<<(std::string_view inData);
+
+        /**
+         * @brief Unmaps the file and truncates it to the written size.
+         */
+        void close();
+
+        bool isOpen() const { return mData != nullptr; }
+
+        std::size_t size() const { return mSize; }
+
+        bool overflow() const { return mOverflow; }
+
+    private:
+
+        int mFd = -1;
+        char* mData = nullptr;
+        std::size_t mCapacity = 0;
+        std::size_t mSize = 0;
+        bool mOverflow = false;
+
+    };
+
+    inline MappedFileStream::MappedFileStream(const char* inPath, std::size_t inCapacity) {
+
+        mFd = ::open(inPath, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (mFd < 0 || !inCapacity || ::ftruncate(mFd, static_cast<off_t>(inCapacity)) != 0) {
+            close();
+            return;
+        }
+
+        void* data = ::mmap(nullptr, inCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+
+        if (data == MAP_FAILED) {
+            close();
+            return;
+        }
+
+        mData = static_cast<char*>(data);
+        mCapacity = inCapacity;
+    }
+
+    inline MappedFileStream& MappedFileStream::operator<<(std::string_view inData) {
+
+        if (mOverflow) {
+            // the output stays a prefix
+            return *this;
+        }
+
+        if (!mData || inData.size() > mCapacity - mSize) {
+            mOverflow = true;
+            return *this;
+        }
+
+        std::memcpy(mData + mSize, inData.data(), inData.size());
+        mSize += inData.size();
+        return *this;
+    }
+
+    inline void MappedFileStream::close() {
+
+        if (mData) {
+            ::munmap(mData, mCapacity);
+            mData = nullptr;
+        }
+
+        if (mFd >= 0) {
+            // drop the unused capacity
+            if (::ftruncate(mFd, static_cast<off_t>(mSize)) != 0) {
+                mOverflow = true;
+            }
+            ::close(mFd);
+            mFd = -1;
+        }
+    }
+
+}
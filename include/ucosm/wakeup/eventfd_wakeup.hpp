@@ -0,0 +1,122 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#if !defined(__linux__)
+#error "EventFdWakeup is only available on Linux"
+#endif
+
+#include "ucosm/core/iwakeup.hpp"
+#include <chrono>
+#include <stdint.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace ucosm {
+
+    /**
+     * @brief Linux eventfd wake-up.
+     *
+     * The file descriptor can also be watched by an external
+     * poll/epoll loop through fd().
+     */
+    struct EventFdWakeup : IWakeup {
+
+        EventFdWakeup() :
+            mFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+        EventFdWakeup(const EventFdWakeup&) = delete;
+        EventFdWakeup& operator=(const EventFdWakeup&) = delete;
+
+        ~EventFdWakeup() {
+            if (mFd >= 0) {
+                close(mFd);
+            }
+        }
+
+        void notify() override;
+
+        /**
+         * @brief Sleeps until notified or until the timeout expires.
+         *
+         * @param inTimeout Maximum sleep duration.
+         * @return true if the thread was notified.
+         */
+        template<typename rep_t, typename period_t>
+        bool waitFor(const std::chrono::duration<rep_t, period_t>& inTimeout);
+
+        /**
+         * @brief Returns the event file descriptor, -1 if its creation failed.
+         *
+         * @return int File descriptor.
+         */
+        int fd() const { return mFd; }
+
+    private:
+
+        bool consume();
+
+        int mFd;
+
+    };
+
+    inline void EventFdWakeup::notify() {
+        const uint64_t value = 1;
+        // can only fail if the counter saturates, which still wakes up
+        [[maybe_unused]] auto r = write(mFd, &value, sizeof(value));
+    }
+
+    inline bool EventFdWakeup::consume() {
+        uint64_t value;
+        return read(mFd, &value, sizeof(value)) == sizeof(value);
+    }
+
+    template<typename rep_t, typename period_t>
+    bool EventFdWakeup::waitFor(const std::chrono::duration<rep_t, period_t>& inTimeout) {
+
+        if (consume()) {
+            // notified before the wait
+            return true;
+        }
+
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(inTimeout).count();
+
+        if (ns > 0) {
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            pollfd p { mFd, POLLIN, 0 };
+            ppoll(&p, 1, &ts, nullptr);
+        }
+
+        return consume();
+    }
+
+}
@@ -0,0 +1,128 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2024 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ucosm                                     *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include "ucosm/core/iwakeup.hpp"
+#include <chrono>
+
+#if defined(__linux__)
+#include <atomic>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace ucosm {
+
+    /**
+     * @brief Thread wake-up.
+     *
+     * Uses a futex on Linux and a condition variable on other platforms.
+     */
+    struct ThreadWakeup : IWakeup {
+
+        void notify() override;
+
+        /**
+         * @brief Sleeps until notified or until the timeout expires.
+         *
+         * @param inTimeout Maximum sleep duration.
+         * @return true if the thread was notified.
+         */
+        template<typename rep_t, typename period_t>
+        bool waitFor(const std::chrono::duration<rep_t, period_t>& inTimeout);
+
+    private:
+
+#if defined(__linux__)
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+        std::atomic<uint32_t> mState { 0 };
+#else
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mState = false;
+#endif
+
+    };
+
+#if defined(__linux__)
+
+    inline void ThreadWakeup::notify() {
+        if (mState.exchange(1, std::memory_order_release) == 0) {
+            syscall(SYS_futex, &mState, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+
+    template<typename rep_t, typename period_t>
+    bool ThreadWakeup::waitFor(const std::chrono::duration<rep_t, period_t>& inTimeout) {
+
+        if (mState.exchange(0, std::memory_order_acquire)) {
+            // notified before the wait
+            return true;
+        }
+
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(inTimeout).count();
+
+        if (ns > 0) {
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            // returns immediately if notify() was called in-between
+            syscall(SYS_futex, &mState, FUTEX_WAIT_PRIVATE, 0, &ts, nullptr, 0);
+        }
+
+        return mState.exchange(0, std::memory_order_acquire) != 0;
+    }
+
+#else
+
+    inline void ThreadWakeup::notify() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mState = true;
+        }
+        mCondition.notify_one();
+    }
+
+    template<typename rep_t, typename period_t>
+    bool ThreadWakeup::waitFor(const std::chrono::duration<rep_t, period_t>& inTimeout) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait_for(lock, inTimeout, [this] () { return mState; });
+        const bool notified = mState;
+        mState = false;
+        return notified;
+    }
+
+#endif
+
+}
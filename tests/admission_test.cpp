@@ -0,0 +1,198 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/periodic/rm_admission.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+
+namespace {
+
+    using admission_clock_t = ucosm::SimClock<struct AdmissionTestTag>;
+
+    struct AdmissionTask : ucosm::IPeriodicTask {
+
+        AdmissionTask(tick_t inPeriod, tick_t inWork = 0) :
+            IPeriodicTask(inPeriod),
+            mWork(inWork) {}
+
+        void run() override {
+            // completion relative to the release
+            const auto start = admission_clock_t::now();
+            admission_clock_t::advance(mWork);
+            const auto response = admission_clock_t::now() - start + (start - getRank());
+            if (response > mMaxResponse) {
+                mMaxResponse = response;
+            }
+        }
+
+        tick_t mWork;
+        tick_t mMaxResponse = 0;
+    };
+
+}
+
+TEST_CASE("Admission control test") {
+
+    using Analysis = ucosm::RMAdmission<4>::Analysis;
+
+    admission_clock_t::set(0);
+
+    ucosm::PeriodicScheduler sched(admission_clock_t::now);
+    ucosm::RMAdmission<4> admission;
+
+    CHECK(admission.getAnalysis() == Analysis::ReleaseOrder);
+    CHECK(admission.utilization() == 0);
+
+    SUBCASE("utilization bound and response time") {
+
+        AdmissionTask t1(10), t2(10), t3(10), t4(10);
+
+        admission.setAnalysis(Analysis::UtilizationBound);
+
+        CHECK(admission.addTask(sched, t1, 3));
+        CHECK(admission.addTask(sched, t2, 3));
+        CHECK(admission.utilization() == 600);
+
+        // 90 % is above the bound of 3 tasks
+        CHECK_FALSE(admission.isSchedulable(t3, 3));
+        CHECK_FALSE(admission.addTask(sched, t3, 3));
+        CHECK_FALSE(t3.isLinked());
+
+        // but the 3 jobs complete within the period
+        admission.setAnalysis(Analysis::ResponseTime);
+        CHECK(admission.addTask(sched, t3, 3));
+        CHECK(admission.utilization() == 900);
+        CHECK(sched.size() == 3);
+
+        // overloaded
+        CHECK_FALSE(admission.addTask(sched, t4, 2));
+        CHECK(admission.addTask(sched, t4, 1));
+        CHECK(admission.utilization() == 1000);
+        CHECK(admission.size() == 4);
+    }
+
+    SUBCASE("release order") {
+
+        AdmissionTask t1(10, 4), t2(100, 5), t3(100, 5);
+
+        CHECK(admission.addTask(sched, t2, 5));
+        CHECK(admission.addTask(sched, t3, 5));
+
+        // t1 can be released right after t2 and t3
+        CHECK_FALSE(admission.addTask(sched, t1, 4));
+
+        // but it would meet its deadlines with rate monotonic priorities
+        admission.setAnalysis(Analysis::ResponseTime);
+        CHECK(admission.isSchedulable(t1, 4));
+
+        admission.setAnalysis(Analysis::ReleaseOrder);
+        t1.setPeriod(14);
+        CHECK(admission.addTask(sched, t1, 4));
+
+        for (; admission_clock_t::now() < 1000; admission_clock_t::advance(1)) {
+            sched.runReady();
+        }
+
+        CHECK(t1.mMaxResponse <= 14);
+        CHECK(t2.mMaxResponse <= 100);
+        CHECK(t3.mMaxResponse <= 100);
+    }
+
+    SUBCASE("blocking") {
+
+        AdmissionTask fast(10), slow(100);
+
+        admission.setAnalysis(Analysis::ResponseTime);
+
+        CHECK(admission.addTask(sched, fast, 5));
+
+        // a slow job running at the fast release makes it complete at 11
+        CHECK_FALSE(admission.isSchedulable(slow, 6));
+        CHECK_FALSE(admission.addTask(sched, slow, 6));
+
+        CHECK(admission.addTask(sched, slow, 5));
+        CHECK(admission.utilization() == 550);
+    }
+
+    SUBCASE("invalid tasks") {
+
+        AdmissionTask t1(10), t2(0);
+
+        CHECK_FALSE(admission.addTask(sched, t1, 11));
+        CHECK_FALSE(admission.addTask(sched, t2, 0));
+        CHECK(admission.size() == 0);
+
+        // already held by a scheduler
+        REQUIRE(sched.addTask(t1));
+        CHECK_FALSE(admission.addTask(sched, t1, 1));
+    }
+
+    SUBCASE("removed tasks") {
+
+        AdmissionTask t1(10), t2(20), t3(40);
+
+        admission.setAnalysis(Analysis::ResponseTime);
+
+        CHECK(admission.addTask(sched, t1, 2));
+        CHECK(admission.addTask(sched, t2, 4));
+        CHECK(admission.addTask(sched, t3, 8));
+        CHECK(admission.utilization() == 600);
+
+        // the table doesn't follow the scheduler
+        t2.removeTask();
+        CHECK(admission.size() == 3);
+        admission.remove(t2);
+        CHECK(admission.size() == 2);
+        CHECK(admission.utilization() == 400);
+
+        // a new execution time for an admitted task,
+        // t1 can be blocked by t3 for 8 ticks
+        CHECK(admission.isSchedulable(t1, 2));
+        CHECK_FALSE(admission.isSchedulable(t1, 3));
+        CHECK(admission.utilization() == 400);
+
+        // forgotten but still scheduled
+        admission.remove(t3);
+        CHECK(admission.size() == 1);
+        CHECK(t3.isLinked());
+    }
+
+    SUBCASE("capacity") {
+
+        AdmissionTask tasks[5] = { 100, 100, 100, 100, 100 };
+
+        for (std::size_t i = 0; i < 4; i++) {
+            CHECK(admission.addTask(sched, tasks[i], 1));
+        }
+
+        CHECK_FALSE(admission.addTask(sched, tasks[4], 1));
+
+        tasks[0].removeTask();
+        CHECK_FALSE(admission.addTask(sched, tasks[4], 1));
+
+        // admitted again without being forgotten first
+        CHECK(admission.addTask(sched, tasks[0], 2));
+        CHECK(admission.size() == 4);
+        CHECK(admission.utilization() == 50);
+
+        tasks[0].removeTask();
+        admission.remove(tasks[0]);
+        CHECK(admission.addTask(sched, tasks[4], 1));
+    }
+
+    SUBCASE("destroyed task") {
+
+        {
+            AdmissionTask t(10);
+            CHECK(admission.addTask(sched, t, 1));
+
+            // forgotten before being destroyed
+            admission.remove(t);
+        }
+
+        CHECK(admission.size() == 0);
+        CHECK(admission.utilization() == 0);
+    }
+
+    sched.clear();
+}
@@ -0,0 +1,216 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/compact/compact_scheduler.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    uint32_t sCompactClock = 0;
+
+    uint32_t getCompactClock() {
+        return sCompactClock;
+    }
+
+    using record_t = std::vector<std::pair<uint32_t, int>>;
+
+    record_t* sCompactRecord = nullptr;
+
+    struct Timer : ucosm::CompactPeriodicTask<Timer> {
+
+        void deinit() {
+            mDeinitCounter++;
+        }
+
+        void run() {
+            sCompactRecord->emplace_back(sCompactClock, mID);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        uint16_t mID = 0;
+        uint16_t mMaxRun = 0;
+        uint16_t mRunCounter = 0;
+        uint16_t mDeinitCounter = 0;
+    };
+
+    struct DynamicTimer : ucosm::IPeriodicTask {
+
+        void run() override {
+            sCompactRecord->emplace_back(sCompactClock, mID);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        uint16_t mID = 0;
+        uint16_t mMaxRun = 0;
+        uint16_t mRunCounter = 0;
+    };
+
+    struct Empty : ucosm::CompactPeriodicTask<Empty> {
+        void run() {}
+    };
+
+    struct WideEmpty : ucosm::CompactPeriodicTask<WideEmpty, uint32_t> {
+        void run() {}
+    };
+
+}
+
+TEST_CASE("Compact task test") {
+
+    SUBCASE("Node size") {
+        static_assert(!std::is_polymorphic_v<Empty>);
+        static_assert(sizeof(Empty) == 12);
+        static_assert(sizeof(WideEmpty) == 16);
+        static_assert(2 * sizeof(WideEmpty) <= sizeof(ucosm::IPeriodicTask));
+    }
+
+    SUBCASE("Same execution as the periodic scheduler") {
+
+        constexpr int task_count = 40;
+
+        for (uint32_t start : { 0u, 0xFFFFFFFFu - 60 }) {
+
+            record_t compactRecord;
+            record_t dynamicRecord;
+
+            sCompactClock = start;
+
+            ucosm::CompactScheduler<Timer, task_count> sched(getCompactClock);
+            ucosm::PeriodicScheduler<> dynamicSched(getCompactClock);
+
+            DynamicTimer timers[task_count];
+
+            for (int i = 0; i < task_count; i++) {
+                auto& t = sched[i];
+                t.mID = timers[i].mID = i;
+                t.mMaxRun = timers[i].mMaxRun = 3 + i % 5;
+                t.mRunCounter = 0;
+                t.setPeriod(1 + (i * 13) % 17);
+                timers[i].setPeriod(t.getPeriod());
+                CHECK(sched.addTask(t));
+                dynamicSched.addTask(timers[i]);
+            }
+
+            CHECK(sched.size() == task_count);
+
+            for (uint32_t t = 0; t < 120; t++) {
+
+                sCompactClock = start + t;
+
+                if (t == 30) {
+                    // removal from outside of the task run
+                    CHECK(sched[13].isLinked());
+                    sched[13].removeTask();
+                    timers[13].removeTask();
+                    CHECK(sched[5].isLinked());
+                    sched.setDelay(sched[5], 20);
+                    dynamicSched.setDelay(timers[5], 20);
+                }
+
+                sCompactRecord = &compactRecord;
+                for (int i = 0; i < task_count + 1; i++) {
+                    sched.run();
+                }
+
+                sCompactRecord = &dynamicRecord;
+                for (int i = 0; i < task_count + 1; i++) {
+                    dynamicSched.run();
+                }
+            }
+
+            CHECK(sched.empty());
+
+            std::sort(compactRecord.begin(), compactRecord.end());
+            std::sort(dynamicRecord.begin(), dynamicRecord.end());
+
+            CHECK(compactRecord == dynamicRecord);
+        }
+    }
+
+    SUBCASE("Remove, update and add again") {
+
+        record_t rec;
+        sCompactRecord = &rec;
+        sCompactClock = 0;
+
+        ucosm::CompactScheduler<Timer, 4> sched(getCompactClock);
+
+        for (int i = 0; i < 4; i++) {
+            sched[i].mID = i;
+            sched[i].setPeriod(10);
+            sched.addTask(sched[i]);
+        }
+
+        CHECK_FALSE(sched.addTask(sched[0]));
+
+        // marked, still in the list
+        sched[2].removeTask();
+        CHECK_FALSE(sched[2].isLinked());
+        CHECK(sched[2].mDeinitCounter == 1);
+        CHECK(sched.size() == 3);
+
+        sched[2].removeTask();
+        CHECK(sched[2].mDeinitCounter == 1);
+
+        // neighbour of a removed task
+        sched[1].setRank(5);
+        CHECK(sched.updateRank(sched[1]));
+        CHECK_FALSE(sched.updateRank(sched[1]));
+        CHECK_FALSE(sched.updateRank(sched[2]));
+
+        // add the removed task back before it is unlinked
+        CHECK(sched.addTask(sched[2]));
+        CHECK(sched.size() == 4);
+
+        for (int i = 0; i < 4; i++) {
+            sched.run();
+        }
+
+        CHECK(rec.size() == 3);
+
+        sCompactClock = 5;
+        sched.run();
+
+        CHECK(rec.size() == 4);
+        CHECK(rec.back().second == 1);
+    }
+
+    SUBCASE("Nested in a periodic scheduler") {
+
+        record_t rec;
+        sCompactRecord = &rec;
+        sCompactClock = 0;
+
+        ucosm::PeriodicScheduler<> mainSched(getCompactClock);
+        ucosm::CompactScheduler<Timer, 2, ucosm::IPeriodicTask> sched(getCompactClock);
+
+        sched.setPeriod(1);
+
+        for (int i = 0; i < 2; i++) {
+            sched[i].mID = i;
+            sched[i].mMaxRun = 2;
+            sched[i].setPeriod(3);
+            sched.addTask(sched[i]);
+        }
+
+        CHECK(mainSched.addTask(sched));
+
+        for (; sCompactClock < 10; sCompactClock++) {
+            mainSched.run();
+            mainSched.run();
+        }
+
+        CHECK(rec == record_t { { 0, 0 }, { 1, 1 }, { 3, 0 }, { 4, 1 } });
+        CHECK(sched.empty());
+    }
+
+}
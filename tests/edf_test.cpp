@@ -0,0 +1,256 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/edf/edf_scheduler.hpp"
+#include "ucosm/core/rb_tree.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    using edf_clock_t = ucosm::SimClock<struct EDFTestTag>;
+
+    std::vector<std::string_view> sRunOrder;
+
+    struct EDFTask : ucosm::IEDFTask {
+
+        EDFTask(std::string_view inName, tick_t inPeriod, tick_t inDeadline = 0, tick_t inOffset = 0) :
+            IEDFTask(inPeriod, inDeadline, inOffset),
+            mName(inName) {}
+
+        void run() override {
+            sRunOrder.push_back(mName);
+            // simulated work
+            edf_clock_t::advance(mWork);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        std::string_view name() override { return mName; }
+
+        std::string_view mName;
+        uint32_t mWork = 0;
+        uint32_t mRunCounter = 0;
+        uint32_t mMaxRun = 0;
+    };
+
+    using order_t = std::vector<std::string_view>;
+
+}
+
+TEST_CASE("EDF scheduler test") {
+
+    sRunOrder.clear();
+
+    SUBCASE("task parameters") {
+
+        EDFTask t("t", 20);
+        CHECK(t.getPeriod() == 20);
+        CHECK(t.getDeadline() == 20);
+        CHECK(t.getOffset() == 0);
+
+        t.setDeadline(5);
+        t.setOffset(3);
+        CHECK(t.getDeadline() == 5);
+        CHECK(t.getOffset() == 3);
+
+        t.setRank(100);
+        CHECK(t.getAbsoluteDeadline() == 105);
+
+        ucosm::EDFScheduler sched(edf_clock_t::now);
+        EDFTask bad("bad", 0);
+        CHECK_FALSE(sched.addTask(bad));
+        CHECK(sched.empty());
+    }
+
+    SUBCASE("earliest deadline first") {
+
+        edf_clock_t::set(0);
+        ucosm::EDFScheduler sched(edf_clock_t::now);
+
+        EDFTask a("a", 20);
+        EDFTask b("b", 20, 5);
+        EDFTask c("c", 20, 1, 2);
+
+        a.mWork = 3;
+        b.mWork = 3;
+
+        REQUIRE(sched.addTask(a));
+        REQUIRE(sched.addTask(b));
+        REQUIRE(sched.addTask(c));
+
+        CHECK(sched.size() == 3);
+
+        // a and b are released, b has the earliest deadline
+        sched.run();
+        CHECK(edf_clock_t::now() == 3);
+
+        // c was released at 2 with a deadline at 3, before a
+        sched.run();
+        sched.run();
+        CHECK(sRunOrder == order_t { "b", "c", "a" });
+        CHECK(edf_clock_t::now() == 6);
+
+        // the next jobs are released one period later
+        CHECK(a.getRank() == 20);
+        CHECK(b.getRank() == 20);
+        CHECK(c.getRank() == 22);
+        CHECK(sched.size() == 3);
+
+        sched.run();
+        CHECK(sRunOrder.size() == 3);
+
+        // c, released last, has the earliest deadline
+        edf_clock_t::set(22);
+        sRunOrder.clear();
+        sched.run();
+        sched.run();
+        sched.run();
+        REQUIRE(sRunOrder.size() == 3);
+        CHECK(sRunOrder[0] == "c");
+    }
+
+    SUBCASE("released jobs are held") {
+
+        edf_clock_t::set(0);
+        ucosm::EDFScheduler sched(edf_clock_t::now);
+
+        EDFTask a("a", 10);
+        EDFTask b("b", 10, 4);
+
+        a.mMaxRun = 1;
+        b.mWork = 1;
+
+        REQUIRE(sched.addTask(a));
+        REQUIRE(sched.addTask(b));
+
+        sched.run();
+        CHECK(sRunOrder == order_t { "b" });
+
+        // a stays released, but counts as a task
+        CHECK(sched.size() == 2);
+        CHECK_FALSE(sched.empty());
+
+        sched.run();
+        CHECK(sRunOrder == order_t { "b", "a" });
+        CHECK_FALSE(a.isLinked());
+        CHECK(sched.size() == 1);
+
+        // a released task can be removed from the outside
+        edf_clock_t::set(10);
+        sched.run();
+        CHECK(b.isLinked());
+        b.removeTask();
+        CHECK(sched.empty());
+
+        REQUIRE(sched.addTask(a));
+        REQUIRE(sched.addTask(b));
+        sched.clear();
+        CHECK(sched.empty());
+        CHECK_FALSE(a.isLinked());
+        CHECK_FALSE(b.isLinked());
+    }
+
+    SUBCASE("tick overflow") {
+
+        edf_clock_t::set(0xFFFFFFFF - 5);
+
+        ucosm::EDFScheduler<ucosm::ITask<int8_t>, ucosm::RBTree> sched(edf_clock_t::now);
+
+        // the absolute deadline of a wraps around
+        EDFTask a("a", 30, 20);
+        EDFTask b("b", 30, 4, 3);
+
+        a.mWork = 4;
+
+        REQUIRE(sched.addTask(a));
+        REQUIRE(sched.addTask(b));
+
+        sched.run();
+        CHECK(edf_clock_t::now() == 0xFFFFFFFF - 1);
+
+        // b is released before the overflow and due right after it
+        sched.run();
+        CHECK(sRunOrder == order_t { "a", "b" });
+
+        edf_clock_t::set(24);
+        sched.run();
+        sched.run();
+        CHECK(sRunOrder == order_t { "a", "b", "a", "b" });
+
+        sched.clear();
+    }
+
+    SUBCASE("overload") {
+
+        edf_clock_t::set(0);
+        ucosm::EDFScheduler sched(edf_clock_t::now);
+
+        EDFTask a("a", 1, 100);
+        EDFTask b("b", 1, 1);
+
+        REQUIRE(sched.addTask(a));
+        REQUIRE(sched.addTask(b));
+
+        sched.run();
+
+        // a waits while b catches up its late releases, which
+        // moves the release cursor past the next release of a
+        edf_clock_t::set(200);
+
+        for (int i = 0; i < 101; i++) {
+            sched.run();
+        }
+
+        sRunOrder.clear();
+
+        for (int i = 0; i < 1000; i++) {
+            edf_clock_t::advance(1);
+            sched.run();
+        }
+
+        std::size_t aRuns = 0;
+        std::size_t bRuns = 0;
+
+        for (const auto& n : sRunOrder) {
+            aRuns += (n == "a");
+            bRuns += (n == "b");
+        }
+
+        // both tasks keep running
+        CHECK(sRunOrder.size() == 1000);
+        CHECK(aRuns > 0);
+        CHECK(bRuns > 0);
+
+        sched.clear();
+    }
+
+    SUBCASE("deadline order over release order") {
+
+        edf_clock_t::set(0);
+        ucosm::EDFScheduler sched(edf_clock_t::now);
+
+        // a long deadline job released first doesn't delay a short one
+        EDFTask slow("slow", 100, 100);
+        EDFTask fast("fast", 10, 2, 1);
+
+        slow.mWork = 1;
+        fast.mWork = 1;
+
+        REQUIRE(sched.addTask(slow));
+        REQUIRE(sched.addTask(fast));
+
+        edf_clock_t::set(1);
+        sched.run();
+        CHECK(sRunOrder == order_t { "fast" });
+
+        sched.run();
+        CHECK(sRunOrder == order_t { "fast", "slow" });
+
+        sched.clear();
+    }
+
+}
@@ -0,0 +1,229 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/cfs/cfs_scheduler.hpp"
+#include "ucosm/core/timing_wheel.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    uint32_t sInboxClock = 0;
+
+    uint32_t getInboxClock() {
+        return sInboxClock;
+    }
+
+    struct OneShotTask : ucosm::IPeriodicTask {
+        void run() override {
+            mRunCounter++;
+            removeTask();
+        }
+        int mID = 0;
+        uint32_t mRunCounter = 0;
+    };
+
+}
+
+TEST_CASE("Task inbox test") {
+
+    SUBCASE("Posted tasks run in post order") {
+
+        sInboxClock = 0;
+
+        std::vector<int> order;
+
+        struct Task : ucosm::IPeriodicTask {
+            Task(std::vector<int>& inOrder, int inID) :
+                ucosm::IPeriodicTask(10), mOrder(inOrder), mID(inID) {}
+            void run() override { mOrder.push_back(mID); }
+            std::vector<int>& mOrder;
+            int mID;
+        };
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, ucosm::TimingWheel> sched(getInboxClock);
+
+        Task t1(order, 1);
+        Task t2(order, 2);
+        Task t3(order, 3);
+
+        sched.post(t1);
+        sched.post(t2);
+        sched.post(t3);
+
+        // not added before the next run
+        CHECK(sched.empty());
+
+        CHECK(sched.runReady() == 3);
+        CHECK(sched.size() == 3);
+        CHECK(order == std::vector<int> { 1, 2, 3 });
+
+        // a removed task can be posted again
+        t2.removeTask();
+        sched.post(t2);
+        CHECK(sched.size() == 2);
+        sched.run();
+        CHECK(sched.size() == 3);
+    }
+
+    SUBCASE("CFS scheduler drains the inbox") {
+
+        sInboxClock = 0;
+
+        struct Task : ucosm::ICFSTask {
+            void run() override { mRunCounter++; }
+            uint32_t mRunCounter = 0;
+        };
+
+        ucosm::CFSScheduler sched(getInboxClock);
+
+        Task t;
+        sched.post(t);
+        sched.run();
+
+        CHECK(t.mRunCounter == 1);
+        CHECK(sched.size() == 1);
+    }
+
+    SUBCASE("Concurrent producers") {
+
+        constexpr int producer_count = 4;
+        constexpr int task_count = 2000;
+
+        sInboxClock = 0;
+
+        ucosm::PeriodicScheduler sched(getInboxClock);
+
+        std::vector<OneShotTask> tasks(producer_count * task_count);
+
+        std::atomic<int> done { 0 };
+
+        std::vector<std::thread> producers;
+
+        for (int p = 0; p < producer_count; p++) {
+            producers.emplace_back(
+                [&, p] () {
+                    for (int i = 0; i < task_count; i++) {
+                        sched.post(tasks[p * task_count + i]);
+                    }
+                    done++;
+                }
+            );
+        }
+
+        std::size_t runCounter = 0;
+
+        while (done != producer_count || !sched.empty()) {
+            runCounter += sched.runReady();
+        }
+
+        // posted after the last check
+        runCounter += sched.runReady();
+
+        for (auto& t : producers) {
+            t.join();
+        }
+
+        CHECK(runCounter == tasks.size());
+
+        bool ranOnce = true;
+        for (auto& t : tasks) {
+            ranOnce &= (t.mRunCounter == 1);
+        }
+        CHECK(ranOnce);
+    }
+
+    SUBCASE("runForever drains a racing post") {
+
+        constexpr int task_count = 2000;
+
+        sInboxClock = 0;
+
+        // yields until the producer is done
+        struct KeeperTask : ucosm::IPeriodicTask {
+            KeeperTask(std::atomic<bool>& inDone) : mDone(inDone) {}
+            void run() override {
+                if (mDone) {
+                    removeTask();
+                }
+            }
+            std::atomic<bool>& mDone;
+        };
+
+        ucosm::PeriodicScheduler sched(getInboxClock);
+
+        std::vector<OneShotTask> tasks(task_count);
+
+        std::atomic<bool> done { false };
+
+        KeeperTask keeper(done);
+        CHECK(sched.addTask(keeper));
+
+        std::thread producer(
+            [&] () {
+                for (auto& t : tasks) {
+                    sched.post(t);
+                }
+                done = true;
+            }
+        );
+
+        // the last posts may land after the inbox was drained
+        // and before the keeper removes itself
+        sched.runForever(
+            [] (uint32_t) {
+                std::this_thread::yield();
+            }
+        );
+
+        producer.join();
+
+        CHECK(sched.empty());
+
+        bool ranOnce = true;
+        for (auto& t : tasks) {
+            ranOnce &= (t.mRunCounter == 1);
+        }
+        CHECK(ranOnce);
+    }
+
+    SUBCASE("runForever drains a post made after the drain") {
+
+        sInboxClock = 0;
+
+        // posts a task, as another thread would, then removes itself
+        struct PosterTask : ucosm::IPeriodicTask {
+            PosterTask(ucosm::PeriodicScheduler<>& inScheduler, OneShotTask& inPosted) :
+                mScheduler(inScheduler), mPosted(inPosted) {}
+            void run() override {
+                mScheduler.post(mPosted);
+                removeTask();
+            }
+            ucosm::PeriodicScheduler<>& mScheduler;
+            OneShotTask& mPosted;
+        };
+
+        ucosm::PeriodicScheduler sched(getInboxClock);
+
+        OneShotTask posted;
+        PosterTask poster(sched, posted);
+
+        CHECK(sched.addTask(poster));
+
+        uint32_t sleepCounter = 0;
+
+        sched.runForever(
+            [&] (uint32_t) {
+                sleepCounter++;
+            }
+        );
+
+        CHECK(posted.mRunCounter == 1);
+        CHECK(sched.empty());
+        CHECK(sleepCounter == 0);
+    }
+
+}
@@ -0,0 +1,288 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/parallel/parallel_cfs_executor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    std::atomic<uint32_t> sParallelClock { 0 };
+
+    uint32_t getParallelClock() {
+        return sParallelClock.load(std::memory_order_relaxed);
+    }
+
+    uint32_t getWallMicros() {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(
+            duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()
+        );
+    }
+
+    // advances the shared clock by its cost on each run
+    struct CostTask : ucosm::ICFSTask {
+
+        void run() override {
+            mLastClock = sParallelClock.fetch_add(mCost, std::memory_order_relaxed) + mCost;
+            if (++mRunCounter == mMaxRun) {
+                this->removeTask();
+            }
+        }
+
+        uint32_t mCost = 1;
+        uint32_t mLastClock = 0;
+        std::atomic<uint32_t> mRunCounter { 0 };
+        uint32_t mMaxRun = 0;
+    };
+
+    // checks that it never runs on two threads at once
+    struct ExclusiveTask : ucosm::ICFSTask {
+
+        void run() override {
+
+            if (mRunning.exchange(true)) {
+                sOverlap = true;
+            }
+
+            const auto id = std::this_thread::get_id();
+            if (id != mLastThread) {
+                mLastThread = id;
+                mThreadChanges++;
+            }
+
+            // leave time to the other workers
+            const auto end = getWallMicros() + 50;
+            while (static_cast<int32_t>(end - getWallMicros()) > 0) {}
+
+            mRunning = false;
+
+            if (++mRunCounter == mMaxRun) {
+                this->removeTask();
+            }
+        }
+
+        void deinit() override { mDeinitCounter++; }
+
+        std::atomic<bool> mRunning { false };
+        std::thread::id mLastThread;
+        uint32_t mThreadChanges = 0;
+        uint32_t mRunCounter = 0;
+        uint32_t mMaxRun = 0;
+        uint32_t mDeinitCounter = 0;
+
+        static inline std::atomic<bool> sOverlap { false };
+    };
+
+    template<typename executor_t>
+    bool waitEmpty(executor_t& inExecutor) {
+        const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (inExecutor.size() && std::chrono::steady_clock::now() < end) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return inExecutor.size() == 0;
+    }
+
+}
+
+TEST_CASE("work stealing deque") {
+
+    int items[4];
+
+    SUBCASE("owner and thief ends") {
+
+        ucosm::WorkStealingDeque<int, 4> deque;
+
+        CHECK(deque.empty());
+        CHECK(deque.pop() == nullptr);
+        CHECK(deque.steal() == nullptr);
+
+        for (auto& i : items) {
+            CHECK(deque.push(&i));
+        }
+
+        // full
+        CHECK_FALSE(deque.push(&items[0]));
+        CHECK(deque.size() == 4);
+
+        // the owner takes the last item, thieves the first one
+        CHECK(deque.pop() == &items[3]);
+        CHECK(deque.steal() == &items[0]);
+        CHECK(deque.steal() == &items[1]);
+        CHECK(deque.pop() == &items[2]);
+        CHECK(deque.empty());
+
+        // the indexes wrap around the buffer
+        for (int n = 0; n < 10; n++) {
+            CHECK(deque.push(&items[n % 4]));
+            CHECK(deque.steal() == &items[n % 4]);
+        }
+        CHECK(deque.empty());
+    }
+
+    SUBCASE("each item is taken once") {
+
+        constexpr int itemCount = 20000;
+
+        static int values[itemCount];
+        ucosm::WorkStealingDeque<int, 256> deque;
+        std::atomic<int> taken[itemCount] {};
+        std::atomic<bool> done { false };
+
+        auto thief = [&] () {
+            while (!done.load()) {
+                if (auto* v = deque.steal()) {
+                    taken[v - values]++;
+                }
+            }
+        };
+
+        std::thread t1(thief);
+        std::thread t2(thief);
+
+        for (int i = 0; i < itemCount; i++) {
+            while (!deque.push(&values[i])) {
+                // full, the owner takes its last item
+                if (auto* v = deque.pop()) {
+                    taken[v - values]++;
+                }
+            }
+            if ((i % 3) == 0) {
+                if (auto* v = deque.pop()) {
+                    taken[v - values]++;
+                }
+            }
+        }
+
+        while (auto* v = deque.pop()) {
+            taken[v - values]++;
+        }
+
+        done = true;
+        t1.join();
+        t2.join();
+
+        bool once = true;
+        for (auto& t : taken) {
+            once &= (t.load() == 1);
+        }
+        CHECK(once);
+    }
+}
+
+TEST_CASE("parallel CFS executor priorities") {
+
+    // a single worker follows the CFSScheduler order
+    ucosm::ParallelCFSExecutor<1> executor(getParallelClock);
+
+    CostTask t1, t2;
+
+    // same cost, t1 rank grows by 1 per run and t2 rank by 4
+    t1.setPriority(0);
+    t2.setPriority(2);
+    t1.mMaxRun = 400;
+    t2.mMaxRun = 100;
+
+    sParallelClock = 0;
+
+    executor.post(t1);
+    executor.post(t2);
+    CHECK(executor.size() == 2);
+
+    CHECK(executor.start());
+    CHECK_FALSE(executor.start());
+    CHECK(waitEmpty(executor));
+    executor.stop();
+    CHECK_FALSE(executor.isRunning());
+
+    CHECK(t1.mRunCounter == 400);
+    CHECK(t2.mRunCounter == 100);
+
+    // both tasks end together, after 500 runs
+    CHECK(t1.mLastClock >= 495);
+    CHECK(t2.mLastClock >= 495);
+    CHECK(executor.stealCount() == 0);
+}
+
+TEST_CASE("parallel CFS executor") {
+
+    constexpr std::size_t taskCount = 16;
+
+    ucosm::ParallelCFSExecutor<4> executor(getWallMicros);
+
+    ExclusiveTask tasks[taskCount];
+
+    for (auto& t : tasks) {
+        t.mMaxRun = 200;
+    }
+
+    bool stealing = false;
+
+    SUBCASE("tasks spread over the workers") {
+        for (auto& t : tasks) {
+            executor.post(t);
+        }
+    }
+
+    SUBCASE("idle workers steal tasks") {
+        // every task starts on the first worker
+        for (auto& t : tasks) {
+            executor.post(t, 0);
+        }
+        stealing = true;
+    }
+
+    CHECK(executor.size() == taskCount);
+    CHECK(executor.start());
+    CHECK(waitEmpty(executor));
+    executor.stop();
+
+    CHECK_FALSE(ExclusiveTask::sOverlap.load());
+
+    uint32_t migrations = 0;
+
+    for (auto& t : tasks) {
+        CHECK(t.mRunCounter == 200);
+        CHECK(t.mDeinitCounter == 1);
+        CHECK_FALSE(t.isLinked());
+        migrations += t.mThreadChanges - 1;
+    }
+
+    if (stealing) {
+        CHECK(executor.stealCount() > 0);
+        CHECK(migrations > 0);
+    }
+}
+
+TEST_CASE("parallel CFS executor restart") {
+
+    ucosm::ParallelCFSExecutor<2> executor(getWallMicros);
+
+    CostTask t;
+    t.mMaxRun = 0xFFFFFFFF;
+
+    executor.post(t);
+    CHECK(executor.start());
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (t.mRunCounter == 0 && std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    executor.stop();
+    const uint32_t runs = t.mRunCounter;
+    CHECK(runs > 0);
+    CHECK(executor.size() == 1);
+
+    // the task is kept and runs again after a restart
+    t.mMaxRun = runs + 10;
+    CHECK(executor.start());
+    CHECK(waitEmpty(executor));
+    executor.stop();
+
+    CHECK(t.mRunCounter == runs + 10);
+    CHECK_FALSE(t.isLinked());
+}
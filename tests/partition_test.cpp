@@ -0,0 +1,192 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/parallel/partitioned_executor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+    uint32_t getPartitionMicros() {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(
+            duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()
+        );
+    }
+
+    // busy for mCost us on each run, checks it never runs on two threads at once
+    struct LoadTask : ucosm::IPeriodicTask {
+
+        LoadTask(uint32_t inPeriod = 1000, uint32_t inCost = 0) :
+            ucosm::IPeriodicTask(inPeriod), mCost(inCost) {}
+
+        void run() override {
+
+            if (mRunning.exchange(true)) {
+                mOverlap = true;
+            }
+
+            mThread.store(std::this_thread::get_id());
+
+            const auto end = getPartitionMicros() + mCost;
+            while (static_cast<int32_t>(end - getPartitionMicros()) > 0) {}
+
+            mRunning = false;
+
+            if (++mRunCounter == mMaxRun) {
+                this->removeTask();
+            }
+        }
+
+        bool init() override { mInitCounter++; return true; }
+        void deinit() override { mDeinitCounter++; }
+
+        uint32_t mCost;
+        std::atomic<bool> mRunning { false };
+        std::atomic<bool> mOverlap { false };
+        std::atomic<std::thread::id> mThread {};
+        std::atomic<uint32_t> mRunCounter { 0 };
+        std::atomic<uint32_t> mMaxRun { 0 };
+        std::atomic<uint32_t> mInitCounter { 0 };
+        std::atomic<uint32_t> mDeinitCounter { 0 };
+    };
+
+    template<typename predicate_t>
+    bool waitUntil(predicate_t&& inPredicate) {
+        const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!inPredicate() && std::chrono::steady_clock::now() < end) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return inPredicate();
+    }
+
+}
+
+TEST_CASE("partitioned executor placement") {
+
+    ucosm::PartitionedExecutor<2, 2> executor(getPartitionMicros, std::chrono::microseconds(1));
+
+    LoadTask tasks[5];
+
+    // no load measured yet, the tasks are spread by count
+    CHECK(executor.post(tasks[0]));
+    CHECK(executor.post(tasks[1]));
+    CHECK(executor.post(tasks[2]));
+    CHECK(executor.size(0) == 2);
+    CHECK(executor.size(1) == 1);
+    CHECK(executor.partitionOf(tasks[0]) == 0);
+    CHECK(executor.partitionOf(tasks[1]) == 1);
+    CHECK(executor.partitionOf(tasks[2]) == 0);
+    CHECK(executor.partitionOf(tasks[4]) == 2);
+
+    // already held
+    CHECK_FALSE(executor.post(tasks[0]));
+
+    // partition 0 is full
+    CHECK_FALSE(executor.post(tasks[3], 0));
+    CHECK_FALSE(executor.post(tasks[3], 2));
+    CHECK(executor.post(tasks[3]));
+    CHECK(executor.partitionOf(tasks[3]) == 1);
+
+    // every partition is full
+    CHECK_FALSE(executor.post(tasks[4]));
+    CHECK(executor.size() == 4);
+
+    CHECK_FALSE(executor.migrate(tasks[4], 1));
+    CHECK_FALSE(executor.migrate(tasks[0], 1));
+    CHECK(executor.migrate(tasks[0], 0));
+}
+
+TEST_CASE("partitioned executor") {
+
+    // declared first, the executor stops before the tasks are destroyed
+    LoadTask t1(500), t2(500);
+
+    ucosm::PartitionedExecutor<2, 8> executor(getPartitionMicros, std::chrono::microseconds(1));
+
+    CHECK(executor.post(t1, 0));
+    CHECK(executor.post(t2, 1));
+
+    CHECK(executor.start());
+    CHECK_FALSE(executor.start());
+
+    CHECK(waitUntil([&] () { return t1.mRunCounter > 5 && t2.mRunCounter > 5; }));
+
+    // each partition has its own thread
+    const bool sameThread = (t1.mThread.load() == t2.mThread.load());
+    CHECK_FALSE(sameThread);
+
+    SUBCASE("explicit migration") {
+
+        CHECK(executor.migrate(t1, 1));
+
+        CHECK(waitUntil([&] () { return executor.partitionOf(t1) == 1; }));
+        CHECK(executor.size(0) == 0);
+        CHECK(executor.size(1) == 2);
+
+        // the task keeps running, on the other thread, without being initialized again
+        const uint32_t runs = t1.mRunCounter;
+        CHECK(waitUntil([&] () { return t1.mRunCounter > runs + 5; }));
+        const bool sameThread = (t1.mThread.load() == t2.mThread.load());
+        CHECK(sameThread);
+        CHECK(t1.mInitCounter == 1);
+        CHECK(t1.mDeinitCounter == 0);
+    }
+
+    SUBCASE("removal") {
+
+        t1.mMaxRun = t1.mRunCounter + 3;
+
+        CHECK(waitUntil([&] () { return executor.size() == 1; }));
+        CHECK(executor.partitionOf(t1) == 2);
+        CHECK(t1.mDeinitCounter == 1);
+        CHECK_FALSE(executor.migrate(t1, 1));
+    }
+
+    executor.stop();
+    CHECK_FALSE(executor.isRunning());
+
+    CHECK_FALSE(t1.mOverlap);
+    CHECK_FALSE(t2.mOverlap);
+
+    // the tasks are kept while stopped
+    const uint32_t runs = t2.mRunCounter;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(t2.mRunCounter == runs);
+
+    CHECK(executor.start());
+    CHECK(waitUntil([&] () { return t2.mRunCounter > runs; }));
+}
+
+TEST_CASE("partitioned executor rebalancing") {
+
+    ucosm::PartitionedExecutor<2, 8> executor(getPartitionMicros, std::chrono::microseconds(1));
+
+    // 20 ms windows, a partition above 50 % gives tasks away
+    executor.setRebalance(20000, 500);
+
+    // 4 tasks busy 20 % of the time, all on the first partition
+    LoadTask tasks[4] = {
+        { 1000, 200 }, { 1000, 200 }, { 1000, 200 }, { 1000, 200 }
+    };
+
+    for (auto& t : tasks) {
+        CHECK(executor.post(t, 0));
+    }
+
+    CHECK(executor.start());
+
+    // the migration is counted once the task has moved
+    CHECK(waitUntil([&] () { return executor.rebalanceCount() >= 1; }));
+    CHECK(executor.size(1) >= 1);
+    CHECK(executor.utilization(0) > 0);
+
+    executor.stop();
+
+    for (auto& t : tasks) {
+        CHECK_FALSE(t.mOverlap);
+        CHECK(t.mInitCounter == 1);
+    }
+}
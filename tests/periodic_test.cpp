@@ -4,6 +4,7 @@
 #include "ucosm/periodic/periodic_scheduler.hpp"
 
 #include <iostream>
+#include <vector>
 #include <iomanip>
 
 TEST_CASE("Periodic task test") {
@@ -92,6 +93,154 @@ TEST_CASE("Periodic task test") {
         CHECK(t3.mRunCounter == 1);
     }
 
+    SUBCASE("Batch execution test") {
+
+        struct Task : ucosm::IPeriodicTask {
+
+            Task(uint32_t inPeriod = 10) : ucosm::IPeriodicTask(inPeriod) {}
+
+            void run() override {
+                mRunCounter++;
+            }
+
+            uint32_t mRunCounter = 0;
+
+        };
+
+        static uint32_t sClock = 0;
+        static uint32_t sIdleCounter = 0;
+
+        ucosm::PeriodicScheduler sched(
+            +[] () {
+                return sClock;
+            },
+            +[] () {
+                sIdleCounter++;
+            }
+        );
+
+        Task tasks[8];
+
+        for (auto& t : tasks) {
+            sched.addTask(t);
+        }
+
+        // every task is ready right after being added
+        CHECK(sched.runReady() == 8);
+        CHECK(sIdleCounter == 0);
+
+        CHECK(sched.runReady() == 0);
+        CHECK(sIdleCounter == 1);
+
+        sClock = 10;
+
+        CHECK(sched.runFor(3, 100) == 3);
+        CHECK(sched.runFor(100, 100) == 5);
+
+        for (auto& t : tasks) {
+            CHECK(t.mRunCounter == 2);
+        }
+
+        // a yielding task ends the burst
+        Task yielding(0);
+        sched.addTask(yielding);
+
+        CHECK(sched.runReady() == 1);
+        CHECK(sched.runReady() == 1);
+        CHECK(yielding.mRunCounter == 2);
+
+        // tick budget
+        sClock = 20;
+        yielding.removeTask();
+
+        struct SlowTask : Task {
+            void run() override {
+                sClock += 5;
+                mRunCounter++;
+            }
+        };
+
+        SlowTask slow[4];
+        for (auto& t : slow) {
+            t.setPeriod(100);
+            sched.addTask(t);
+        }
+
+        CHECK(sched.runFor(100, 10) == 2);
+    }
+
+    SUBCASE("Tickless idle test") {
+
+        struct Task : ucosm::IPeriodicTask {
+
+            Task(uint32_t inPeriod, uint32_t inRunCount) :
+                ucosm::IPeriodicTask(inPeriod), mRunCount(inRunCount) {}
+
+            void run() override {
+                if (++mRunCounter == mRunCount) {
+                    removeTask();
+                }
+            }
+
+            uint32_t mRunCount;
+            uint32_t mRunCounter = 0;
+
+        };
+
+        static uint32_t sClock = 100;
+        static uint32_t sIdleCounter = 0;
+
+        ucosm::PeriodicScheduler sched(
+            +[] () {
+                return sClock;
+            },
+            +[] () {
+                sIdleCounter++;
+            }
+        );
+
+        CHECK(sched.ticksUntilNext() == 0xFFFFFFFF);
+
+        Task t1(7, 10);
+        Task t2(25, 3);
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+
+        CHECK(sched.ticksUntilNext() == 0);
+
+        sched.runReady();
+
+        CHECK(sched.ticksUntilNext() == 7);
+
+        sClock += 3;
+        CHECK(sched.ticksUntilNext() == 4);
+
+        std::vector<uint32_t> sleeps;
+
+        sched.runForever(
+            [&] (uint32_t inTicks) {
+                sleeps.push_back(inTicks);
+                sClock += inTicks;
+            }
+        );
+
+        CHECK(sched.empty());
+        CHECK(t1.mRunCounter == 10);
+        CHECK(t2.mRunCounter == 3);
+
+        // only the first burst, started between two tasks, is idle
+        CHECK(sIdleCounter == 1);
+
+        // t1 at 7, 14, 21, 25 (t2), 28, ...
+        CHECK(sleeps.size() == 11);
+        CHECK(sleeps[0] == 4);
+        CHECK(sleeps[1] == 7);
+        CHECK(sleeps[2] == 7);
+        CHECK(sleeps[3] == 4);
+        CHECK(sleeps[4] == 3);
+    }
+
     SUBCASE("Basic test") {
 
         struct Task : ucosm::IPeriodicTask {
@@ -239,4 +388,176 @@ TEST_CASE("Periodic task test") {
 
     }
 
-}
\ No newline at end of file
+}
+TEST_CASE("Periodic phase modes") {
+
+    using PhaseMode = ucosm::IPeriodicTask::PhaseMode;
+
+    struct Task : ucosm::IPeriodicTask {
+
+        Task() : ucosm::IPeriodicTask(10) {}
+
+        void run() override {
+            mRunCounter++;
+        }
+
+        uint32_t mRunCounter = 0;
+
+    };
+
+    static uint32_t sClock;
+
+    struct Expected {
+        PhaseMode mode;
+        uint32_t rankAfterLateRun;
+        std::size_t runsAfterOverrun;
+        uint32_t rankAfterOverrun;
+    };
+
+    // period 10, run at 0, late by 3 at 13, then overrun until 45
+    const Expected expected[] = {
+        { PhaseMode::Free, 23, 1, 55 },
+        { PhaseMode::CatchUp, 20, 3, 50 },
+        { PhaseMode::Skip, 20, 1, 50 },
+        { PhaseMode::Compress, 20, 2, 50 }
+    };
+
+    for (const auto& e : expected) {
+
+        CAPTURE(static_cast<int>(e.mode));
+
+        Task t;
+        t.setPhaseMode(e.mode);
+        CHECK(t.getPhaseMode() == e.mode);
+
+        sClock = 0;
+
+        ucosm::PeriodicScheduler sched(
+            +[] () {
+                return sClock;
+            }
+        );
+
+        sched.addTask(t);
+
+        CHECK(sched.runReady() == 1);
+        CHECK(t.getRank() == 10);
+
+        sClock = 13;
+        CHECK(sched.runReady() == 1);
+        CHECK(t.getRank() == e.rankAfterLateRun);
+
+        sClock = 45;
+        CHECK(sched.runReady() == e.runsAfterOverrun);
+        CHECK(t.getRank() == e.rankAfterOverrun);
+    }
+
+    SUBCASE("Null period") {
+
+        Task t;
+        t.setPeriod(0);
+        t.setPhaseMode(PhaseMode::CatchUp);
+
+        // a yield is still rescheduled at the dispatch tick
+        CHECK(t.nextRelease(5, 12) == 12);
+    }
+
+    SUBCASE("Wrap around") {
+
+        Task t;
+        t.setPhaseMode(PhaseMode::Skip);
+
+        // releases at -6, 4, 14, 24
+        CHECK(t.nextRelease(0xFFFFFFFA, 0x00000011) == 0x00000018);
+    }
+}
+
+TEST_CASE("Periodic deadline misses") {
+
+    using DeadlineMiss = ucosm::IPeriodicTask::DeadlineMiss;
+
+    static uint32_t sClock;
+
+    struct Task : ucosm::IPeriodicTask {
+
+        Task() : ucosm::IPeriodicTask(10) {}
+
+        void run() override {
+            // simulated work
+            sClock += mWork;
+        }
+
+        void onDeadlineMiss(DeadlineMiss inMiss, tick_t inTicks) override {
+            mLastMiss = inMiss;
+            mLastTicks = inTicks;
+        }
+
+        uint32_t mWork = 0;
+        DeadlineMiss mLastMiss = DeadlineMiss::LateStart;
+        tick_t mLastTicks = 0;
+
+    };
+
+    sClock = 0;
+
+    ucosm::PeriodicScheduler sched(
+        +[] () {
+            return sClock;
+        }
+    );
+
+    Task t;
+    t.setDeadline(2);
+    CHECK(t.getDeadline() == 2);
+
+    sched.addTask(t);
+
+    // on time
+    CHECK(sched.runReady() == 1);
+    CHECK(t.getLateStarts() == 0);
+    CHECK(t.getOverruns() == 0);
+
+    // late within the tolerance
+    sClock = 12;
+    CHECK(sched.runReady() == 1);
+    CHECK(t.getLateStarts() == 0);
+
+    // late by 5
+    sClock = 27;
+    CHECK(sched.runReady() == 1);
+    CHECK(t.getLateStarts() == 1);
+    CHECK(t.mLastMiss == DeadlineMiss::LateStart);
+    CHECK(t.mLastTicks == 5);
+    CHECK(sched.deadlineMisses() == 1);
+
+    // on time but longer than the period
+    sClock = t.getRank();
+    t.mWork = 12;
+    CHECK(sched.runReady() == 1);
+    CHECK(t.getLateStarts() == 1);
+    CHECK(t.getOverruns() == 1);
+    CHECK(t.mLastMiss == DeadlineMiss::Overrun);
+    CHECK(t.mLastTicks == 12);
+    CHECK(sched.deadlineMisses() == 2);
+
+    // late and too long
+    sClock = t.getRank() + 3;
+    CHECK(sched.runReady() == 1);
+    CHECK(t.getLateStarts() == 2);
+    CHECK(t.getOverruns() == 2);
+    CHECK(sched.deadlineMisses() == 4);
+
+    t.resetDeadlineMisses();
+    CHECK(t.getLateStarts() == 0);
+    CHECK(t.getOverruns() == 0);
+
+    // a null deadline disables the checks
+    t.setDeadline(0);
+    sClock = t.getRank() + 30;
+    CHECK(sched.runReady() == 1);
+    CHECK(t.getLateStarts() == 0);
+    CHECK(t.getOverruns() == 0);
+    CHECK(sched.deadlineMisses() == 4);
+
+    t.removeTask();
+}
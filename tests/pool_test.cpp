@@ -0,0 +1,239 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/core/task_pool.hpp"
+#include "ucosm/core/callable_task.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    using pool_clock_t = ucosm::SimClock<struct PoolTestTag>;
+
+    int sAlive = 0;
+
+    struct CountedTask : ucosm::IPeriodicTask {
+
+        CountedTask(int inID, int inMaxRun, std::vector<int>& inRecord, bool inInit = true) :
+            IPeriodicTask(1),
+            mID(inID),
+            mMaxRun(inMaxRun),
+            mRecord(inRecord),
+            mInit(inInit) {
+            sAlive++;
+        }
+
+        ~CountedTask() {
+            sAlive--;
+        }
+
+        bool init() override {
+            return mInit;
+        }
+
+        void deinit() override {
+            mDeinitCounter++;
+        }
+
+        void run() override {
+            mRecord.push_back(mID);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        int mID;
+        int mMaxRun;
+        int mRunCounter = 0;
+        int mDeinitCounter = 0;
+        std::vector<int>& mRecord;
+        bool mInit;
+    };
+
+}
+
+TEST_CASE("Task pool test") {
+
+    pool_clock_t::set(0);
+    sAlive = 0;
+
+    SUBCASE("Spawn and release") {
+
+        std::vector<int> rec;
+
+        {
+            ucosm::PeriodicScheduler<> sched(pool_clock_t::now);
+            ucosm::TaskPool<CountedTask, 3> pool;
+
+            CHECK(pool.available() == 3);
+
+            auto* t0 = pool.spawn(sched, 0, 1, rec);
+            auto* t1 = pool.spawn(sched, 1, 2, rec);
+            auto* t2 = pool.spawn(sched, 2, 3, rec);
+
+            REQUIRE(t0);
+            REQUIRE(t1);
+            REQUIRE(t2);
+
+            CHECK(t0->isLinked());
+            CHECK(pool.available() == 0);
+            CHECK(sched.size() == 3);
+
+            // pool is full
+            CHECK(pool.spawn(sched, 3, 1, rec) == nullptr);
+            CHECK(sAlive == 3);
+
+            // t0 is removed during its first run
+            for (int i = 0; i < 3; i++) {
+                sched.run();
+            }
+            CHECK(t0->mDeinitCounter == 1);
+            CHECK(pool.available() == 1);
+
+            // the released slot is reused
+            auto* t3 = pool.spawn(sched, 3, 1, rec);
+            CHECK(t3 == t0);
+            CHECK(sAlive == 3);
+
+            // init failure gives the slot back
+            CHECK(pool.available() == 0);
+            CHECK(pool.spawn(sched, 4, 1, rec, false) == nullptr);
+
+            // removal from outside of the run
+            t2->removeTask();
+            CHECK(pool.available() == 1);
+            CHECK(pool.spawn(sched, 4, 1, rec, false) == nullptr);
+            CHECK(pool.available() == 1);
+
+            for (pool_clock_t::set(1); pool_clock_t::now() < 5; pool_clock_t::advance(1)) {
+                sched.run();
+                sched.run();
+            }
+
+            CHECK(sched.empty());
+            CHECK(pool.available() == 3);
+            std::sort(rec.begin(), rec.end());
+            CHECK(rec == std::vector<int> { 0, 1, 1, 2, 3 });
+
+            // still constructed, destroyed with the pool
+            CHECK(sAlive == 3);
+        }
+
+        CHECK(sAlive == 0);
+    }
+
+    SUBCASE("Released slots are reused in release order") {
+
+        std::vector<int> rec;
+
+        ucosm::PeriodicScheduler<> sched(pool_clock_t::now);
+        ucosm::TaskPool<CountedTask, 3> pool;
+
+        auto* t0 = pool.spawn(sched, 0, 1, rec);
+        auto* t1 = pool.spawn(sched, 1, 1, rec);
+
+        t1->removeTask();
+        t0->removeTask();
+
+        // never released slot first, then t1 and t0
+        auto* a = pool.spawn(sched, 2, 1, rec);
+        auto* b = pool.spawn(sched, 3, 1, rec);
+        auto* c = pool.spawn(sched, 4, 1, rec);
+
+        CHECK(a != t0);
+        CHECK(a != t1);
+        CHECK(b == t1);
+        CHECK(c == t0);
+    }
+
+    SUBCASE("Pooled callable tasks") {
+
+        ucosm::PeriodicScheduler<> sched(pool_clock_t::now);
+        ucosm::TaskPool<ucosm::CallableTask<ucosm::IPeriodicTask>, 4> pool;
+
+        int counter = 0;
+
+        for (int i = 0; i < 4; i++) {
+            auto* t = pool.spawn(sched, [&] {
+                counter++;
+                // one-shot
+                sched.thisTask()->removeTask();
+                });
+            REQUIRE(t);
+            t->setPeriod(1);
+        }
+
+        CHECK(pool.available() == 0);
+
+        while (!sched.empty()) {
+            sched.run();
+        }
+
+        CHECK(counter == 4);
+        CHECK(pool.available() == 4);
+
+        // the pool keeps spawning without heap allocation
+        for (int round = 0; round < 10; round++) {
+            REQUIRE(pool.spawn(sched, [&] {
+                counter++;
+                sched.thisTask()->removeTask();
+                }));
+            sched.run();
+        }
+
+        CHECK(counter == 14);
+        CHECK(pool.available() == 4);
+    }
+
+    SUBCASE("A task spawns its successor") {
+
+        ucosm::PeriodicScheduler<> sched(pool_clock_t::now);
+        ucosm::PeriodicScheduler<> otherSched(pool_clock_t::now);
+        ucosm::TaskPool<ucosm::CallableTask<ucosm::IPeriodicTask>, 2> pool;
+
+        struct {
+            ucosm::PeriodicScheduler<>* otherSched = nullptr;
+            ucosm::IPeriodicTask* other = nullptr;
+            ucosm::IPeriodicTask* successor = nullptr;
+            bool ran = false;
+        } state;
+
+        state.otherSched = &otherSched;
+
+        auto spawnSuccessor = [&state, &sched, &pool] {
+            sched.thisTask()->removeTask();
+            state.other->removeTask();
+
+            // the slot of the running task isn't free before its run returns
+            CHECK(pool.available() == 1);
+
+            // whatever the scheduler the successor goes to
+            state.successor = pool.spawn(*state.otherSched, [] {});
+            CHECK(state.successor == state.other);
+            CHECK(pool.spawn(sched, [] {}) == nullptr);
+            CHECK(pool.available() == 0);
+            state.ran = true;
+        };
+
+        // the last added task runs first
+        state.other = pool.spawn(sched, [] {});
+        REQUIRE(state.other);
+        auto* first = pool.spawn(sched, spawnSuccessor);
+        REQUIRE(first);
+
+        sched.run();
+
+        CHECK(state.ran);
+        CHECK(sched.empty());
+        CHECK(otherSched.size() == 1);
+        CHECK(state.successor->isLinked());
+
+        // released once its run returned
+        CHECK(pool.available() == 1);
+        CHECK(pool.spawn(sched, [] {}) == first);
+    }
+
+}
@@ -0,0 +1,179 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/priority/priority_scheduler.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    std::vector<std::string_view> sPriorityOrder;
+
+    using priority_clock_t = ucosm::SimClock<struct PriorityTestTag>;
+
+    struct PriorityTask : ucosm::IPriorityTask {
+
+        PriorityTask(std::string_view inName, priority_t inPriority) :
+            IPriorityTask(inPriority),
+            mName(inName) {}
+
+        void run() override {
+            sPriorityOrder.push_back(mName);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        std::string_view name() override { return mName; }
+
+        std::string_view mName;
+        uint32_t mRunCounter = 0;
+        uint32_t mMaxRun = 0;
+    };
+
+    using order_t = std::vector<std::string_view>;
+
+}
+
+TEST_CASE("Priority scheduler test") {
+
+    sPriorityOrder.clear();
+
+    SUBCASE("priority order and round robin") {
+
+        ucosm::PriorityScheduler sched;
+
+        PriorityTask low("low", 5);
+        PriorityTask a("a", 1);
+        PriorityTask b("b", 1);
+
+        low.mMaxRun = 1;
+        a.mMaxRun = 2;
+        b.mMaxRun = 2;
+
+        CHECK(sched.addTask(low));
+        CHECK(sched.addTask(a));
+        CHECK(sched.addTask(b));
+        CHECK(sched.size() == 3);
+        CHECK(sched.getNextRank() == 1);
+
+        while (!sched.empty()) {
+            sched.run();
+        }
+
+        // the low priority task waits for the level 1 to be empty
+        CHECK(sPriorityOrder == order_t { "a", "b", "a", "b", "low" });
+    }
+
+    SUBCASE("removal and priority change") {
+
+        static int sIdleCount;
+        sIdleCount = 0;
+
+        ucosm::PriorityScheduler sched(+[] () { sIdleCount++; });
+
+        PriorityTask high("high", 0);
+        PriorityTask mid("mid", 3);
+        PriorityTask low("low", 200);
+
+        PriorityTask* tasks[] = { &high, &mid, &low };
+        CHECK(sched.addTasks(std::begin(tasks), std::end(tasks)) == 3);
+
+        sched.run();
+        sched.run();
+        CHECK(sPriorityOrder == order_t { "high", "high" });
+
+        // the priority applies after the next run
+        high.setPriority(4);
+        sched.run();
+        sched.run();
+        CHECK(sPriorityOrder == order_t { "high", "high", "high", "mid" });
+
+        // mid was the last of its level
+        mid.removeTask();
+        sched.run();
+        CHECK(sPriorityOrder.back() == "high");
+
+        high.removeTask();
+
+        // beyond the last level
+        sched.run();
+        CHECK(sPriorityOrder.back() == "low");
+
+        low.removeTask();
+        CHECK(sched.empty());
+        sched.run();
+        CHECK(sIdleCount == 1);
+    }
+
+    SUBCASE("64 levels") {
+
+        ucosm::PriorityScheduler<64> sched;
+
+        PriorityTask t63("t63", 63);
+        PriorityTask t40("t40", 40);
+        PriorityTask t33("t33", 33);
+
+        CHECK(sched.addTask(t63));
+        CHECK(sched.addTask(t40));
+        CHECK(sched.addTask(t33));
+
+        sched.run();
+        t33.removeTask();
+        sched.run();
+        t40.removeTask();
+        sched.run();
+
+        CHECK(sPriorityOrder == order_t { "t33", "t40", "t63" });
+
+        sched.clear();
+        CHECK_FALSE(t63.isLinked());
+    }
+
+    SUBCASE("posted tasks") {
+
+        ucosm::PriorityScheduler sched;
+
+        PriorityTask a("a", 2);
+        PriorityTask b("b", 1);
+
+        CHECK(sched.addTask(a));
+        sched.post(b);
+
+        sched.run();
+        CHECK(sPriorityOrder == order_t { "b" });
+
+        sched.clear();
+    }
+
+    SUBCASE("nested in a periodic scheduler") {
+
+        priority_clock_t::set(0);
+
+        ucosm::PeriodicScheduler outer(priority_clock_t::now);
+        ucosm::PriorityScheduler<32, ucosm::IPeriodicTask> inner;
+
+        inner.setPeriod(10);
+
+        PriorityTask a("a", 0);
+        PriorityTask b("b", 1);
+
+        CHECK(inner.addTask(a));
+        CHECK(inner.addTask(b));
+        CHECK(outer.addTask(inner));
+
+        // one task of the nested scheduler per period
+        for (priority_clock_t::set(0); priority_clock_t::now() < 30; priority_clock_t::advance(1)) {
+            outer.run();
+        }
+
+        CHECK(sPriorityOrder == order_t { "a", "a", "a" });
+
+        inner.clear();
+        outer.clear();
+    }
+
+}
@@ -0,0 +1,565 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/cfs/cfs_scheduler.hpp"
+#include "ucosm/core/pairing_heap.hpp"
+#include "ucosm/core/timing_wheel.hpp"
+#include "ucosm/core/rb_tree.hpp"
+#include "ucosm/core/rank_table.hpp"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+
+namespace {
+
+    uint32_t sQueueClock = 0;
+
+    uint32_t getQueueClock() {
+        return sQueueClock;
+    }
+
+    struct RecordTask : ucosm::IPeriodicTask {
+
+        RecordTask(int inID = 0, uint32_t inPeriod = 0) :
+            ucosm::IPeriodicTask(inPeriod), mID(inID) {}
+
+        bool init() override {
+            return mInit;
+        }
+
+        void run() override {
+            if (mRecord) {
+                mRecord->emplace_back(sQueueClock, mID);
+            }
+            mRunCounter++;
+        }
+
+        std::vector<std::pair<uint32_t, int>>* mRecord = nullptr;
+        uint32_t mRunCounter = 0;
+        int mID;
+        bool mInit = true;
+    };
+
+    template<template<typename> typename queue_t>
+    std::vector<std::pair<uint32_t, int>> recordPeriodic(
+        uint32_t inStart,
+        uint32_t inPeriodRange = 23,
+        uint32_t inStep = 1
+    ) {
+
+        constexpr int task_count = 64;
+
+        std::vector<std::pair<uint32_t, int>> record;
+
+        sQueueClock = inStart;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, queue_t> sched(getQueueClock);
+
+        RecordTask tasks[task_count];
+
+        for (int i = 0; i < task_count; i++) {
+            tasks[i].mID = i;
+            tasks[i].setPeriod(1 + (i * 7919) % inPeriodRange);
+            tasks[i].mRecord = &record;
+            sched.addTask(tasks[i]);
+        }
+
+        for (uint32_t t = 0; t < 500; t++) {
+
+            sQueueClock = inStart + t * inStep;
+
+            for (int i = 0; i < task_count + 1; i++) {
+                sched.run();
+            }
+
+            if (t == 250) {
+                // remove a few tasks while running
+                for (int i = 0; i < task_count; i += 5) {
+                    tasks[i].removeTask();
+                }
+                // and reschedule a few others
+                for (int i = 1; i < task_count; i += 9) {
+                    if (tasks[i].isLinked()) {
+                        sched.setDelay(tasks[i], i * inStep);
+                    }
+                }
+            }
+        }
+
+        std::sort(record.begin(), record.end());
+        return record;
+    }
+
+    template<template<typename> typename queue_t>
+    std::vector<int> recordBatch() {
+
+        constexpr int task_count = 6;
+
+        std::vector<std::pair<uint32_t, int>> record;
+
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, queue_t> sched(getQueueClock);
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, queue_t> other(getQueueClock);
+
+        RecordTask tasks[task_count];
+
+        for (int i = 0; i < task_count; i++) {
+            tasks[i].mID = i;
+            tasks[i].setPeriod(10);
+            tasks[i].mRecord = &record;
+        }
+
+        // already linked
+        other.addTask(tasks[2]);
+
+        // init failure
+        tasks[4].mInit = false;
+
+        bool mask[task_count] = {};
+
+        CHECK(sched.addTasks(std::begin(tasks), std::end(tasks), mask) == 4);
+
+        CHECK(mask[0]);
+        CHECK(mask[1]);
+        CHECK_FALSE(mask[2]);
+        CHECK(mask[3]);
+        CHECK_FALSE(mask[4]);
+        CHECK(mask[5]);
+
+        CHECK(sched.size() == 4);
+        CHECK(other.size() == 1);
+
+        for (int i = 0; i < task_count; i++) {
+            sched.run();
+        }
+
+        std::vector<int> ids;
+        for (auto& r : record) {
+            ids.push_back(r.second);
+        }
+        return ids;
+    }
+
+}
+
+TEST_CASE("Ready queue test") {
+
+    SUBCASE("Task size") {
+        // vtable, list links, rank, child link and unlink function
+        static_assert(sizeof(ucosm::ITask<uint32_t>) == 6 * sizeof(void*));
+    }
+
+    SUBCASE("Pairing heap timer overflow test") {
+
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, ucosm::PairingHeap> sched(getQueueClock);
+
+        RecordTask t1;
+        RecordTask t2;
+        RecordTask t3;
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+        sched.addTask(t3);
+
+        t1.setPeriod(0xFFFFFFFE);
+        t2.setPeriod(0xFF);
+        t3.setPeriod(0xFF);
+
+        sched.setDelay(t1, 0x000000FF);
+        sched.setDelay(t2, 0xFFFFFFFF - 10);
+        sched.setDelay(t3, 0xFFFFFFFF - 1);
+
+        sched.run();
+
+        CHECK(t1.mRunCounter == 0);
+        CHECK(t2.mRunCounter == 0);
+        CHECK(t3.mRunCounter == 0);
+
+        sQueueClock = 256;
+        sched.run();
+
+        CHECK(t1.mRunCounter == 1);
+        CHECK(t2.mRunCounter == 0);
+        CHECK(t3.mRunCounter == 0);
+
+        sQueueClock = 0xFFFFFFFF - 9;
+        sched.run();
+
+        CHECK(t1.mRunCounter == 1);
+        CHECK(t2.mRunCounter == 1);
+        CHECK(t3.mRunCounter == 0);
+
+        sQueueClock = 5;
+        sched.run();
+
+        CHECK(t1.mRunCounter == 1);
+        CHECK(t2.mRunCounter == 1);
+        CHECK(t3.mRunCounter == 1);
+
+        sQueueClock = 244;
+        sched.run();
+
+        CHECK(t2.mRunCounter == 1);
+
+        sQueueClock = 245;
+        sched.run();
+
+        CHECK(t1.mRunCounter == 1);
+        CHECK(t2.mRunCounter == 2);
+        CHECK(t3.mRunCounter == 1);
+    }
+
+    SUBCASE("Pairing heap matches sorted list") {
+
+        const auto listRecord = recordPeriodic<ucosm::SortedList>(1000);
+        const auto heapRecord = recordPeriodic<ucosm::PairingHeap>(1000);
+
+        CHECK(!listRecord.empty());
+        CHECK(listRecord == heapRecord);
+
+        // same scenario crossing the tick overflow
+        const auto wrapListRecord = recordPeriodic<ucosm::SortedList>(0xFFFFFF00);
+        const auto wrapHeapRecord = recordPeriodic<ucosm::PairingHeap>(0xFFFFFF00);
+
+        CHECK(wrapListRecord == wrapHeapRecord);
+    }
+
+    SUBCASE("Timing wheel matches sorted list") {
+
+        CHECK(recordPeriodic<ucosm::SortedList>(1000) == recordPeriodic<ucosm::TimingWheel>(1000));
+
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(0xFFFFFF00) ==
+            recordPeriodic<ucosm::TimingWheel>(0xFFFFFF00)
+        );
+
+        // periods spread over every level
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(12345, 60'000, 97) ==
+            recordPeriodic<ucosm::TimingWheel>(12345, 60'000, 97)
+        );
+
+        // periods reaching the overflow list
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(0xFF000000, 0x40000000, 0x00F00000) ==
+            recordPeriodic<ucosm::TimingWheel>(0xFF000000, 0x40000000, 0x00F00000)
+        );
+    }
+
+    SUBCASE("Timing wheel timer overflow test") {
+
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, ucosm::TimingWheel> sched(getQueueClock);
+
+        RecordTask t1;
+        RecordTask t2;
+        RecordTask t3;
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+        sched.addTask(t3);
+
+        t1.setPeriod(0xFFFFFFFE);
+        t2.setPeriod(0xFF);
+        t3.setPeriod(0xFF);
+
+        sched.setDelay(t1, 0x000000FF);
+        sched.setDelay(t2, 0xFFFFFFFF - 10);
+        sched.setDelay(t3, 0xFFFFFFFF - 1);
+
+        CHECK(sched.size() == 3);
+
+        sched.run();
+        CHECK(t1.mRunCounter == 0);
+
+        sQueueClock = 256;
+        sched.run();
+        CHECK(t1.mRunCounter == 1);
+
+        sQueueClock = 0xFFFFFFFF - 9;
+        sched.run();
+        CHECK(t2.mRunCounter == 1);
+        CHECK(t3.mRunCounter == 0);
+
+        sQueueClock = 5;
+        sched.run();
+        CHECK(t3.mRunCounter == 1);
+
+        sQueueClock = 244;
+        sched.run();
+        CHECK(t2.mRunCounter == 1);
+
+        sQueueClock = 245;
+        sched.run();
+        CHECK(t1.mRunCounter == 1);
+        CHECK(t2.mRunCounter == 2);
+        CHECK(t3.mRunCounter == 1);
+
+        t2.removeTask();
+        CHECK(sched.size() == 2);
+
+        sched.clear();
+        CHECK(sched.empty());
+        CHECK(!t1.isLinked());
+    }
+
+    SUBCASE("Pairing heap task lifetime") {
+
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, ucosm::PairingHeap> sched(getQueueClock);
+
+        RecordTask t1(1, 10);
+        RecordTask t2(2, 20);
+
+        CHECK(sched.empty());
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+
+        CHECK(!sched.addTask(t1));
+
+        {
+            RecordTask tasks[16];
+            for (auto& t : tasks) {
+                t.setPeriod(3);
+                sched.addTask(t);
+            }
+            CHECK(sched.size() == 18);
+
+            for (int i = 0; i < 8; i++) {
+                sched.run();
+            }
+
+            tasks[3].removeTask();
+            CHECK(!tasks[3].isLinked());
+            CHECK(sched.size() == 17);
+        }
+
+        CHECK(sched.size() == 2);
+
+        std::stringstream names;
+        sched.list(names, ",");
+        CHECK(names.str() == ",,");
+
+        sched.clear();
+        CHECK(sched.empty());
+        CHECK(!t1.isLinked());
+        CHECK(!t2.isLinked());
+    }
+
+    SUBCASE("Red-black tree matches sorted list") {
+
+        CHECK(recordPeriodic<ucosm::SortedList>(1000) == recordPeriodic<ucosm::RBTree>(1000));
+
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(0xFFFFFF00) ==
+            recordPeriodic<ucosm::RBTree>(0xFFFFFF00)
+        );
+
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(12345, 60'000, 97) ==
+            recordPeriodic<ucosm::RBTree>(12345, 60'000, 97)
+        );
+    }
+
+    SUBCASE("Rank table matches sorted list") {
+
+        CHECK(recordPeriodic<ucosm::SortedList>(1000) == recordPeriodic<ucosm::FixedRankTable<64>::type>(1000));
+
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(0xFFFFFF00) ==
+            recordPeriodic<ucosm::FixedRankTable<64>::type>(0xFFFFFF00)
+        );
+
+        CHECK(
+            recordPeriodic<ucosm::SortedList>(12345, 60'000, 97) ==
+            recordPeriodic<ucosm::FixedRankTable<64>::type>(12345, 60'000, 97)
+        );
+    }
+
+    SUBCASE("Rank table capacity") {
+
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, ucosm::FixedRankTable<4>::type> sched(getQueueClock);
+
+        RecordTask tasks[6];
+
+        CHECK(sched.addTask(tasks[0]));
+        CHECK(sched.addTask(tasks[1]));
+
+        bool mask[5] = {};
+        CHECK(sched.addTasks(tasks + 1, tasks + 6, mask) == 2);
+
+        CHECK_FALSE(mask[0]);
+        CHECK(mask[1]);
+        CHECK(mask[2]);
+        CHECK_FALSE(mask[3]);
+        CHECK_FALSE(mask[4]);
+
+        CHECK(sched.size() == 4);
+        CHECK_FALSE(sched.addTask(tasks[5]));
+
+        tasks[2].removeTask();
+        CHECK(sched.addTask(tasks[5]));
+        CHECK(sched.size() == 4);
+    }
+
+    SUBCASE("Vectorized rank search") {
+
+        std::srand(7);
+
+        std::vector<uint32_t> ranks(300);
+
+        for (std::size_t count = 1; count <= ranks.size(); count += 7) {
+
+            for (int trial = 0; trial < 20; trial++) {
+
+                const uint32_t cursor = static_cast<uint32_t>(std::rand()) * 65537u;
+
+                for (std::size_t i = 0; i < count; i++) {
+                    // ranks around the cursor with duplicates
+                    ranks[i] = cursor + static_cast<uint32_t>(std::rand() % 50) * 0x01000000u;
+                }
+
+                CHECK(
+                    ucosm::ranks::lowest(ranks.data(), count, cursor) ==
+                    ucosm::ranks::lowestScalar(ranks.data(), count, cursor)
+                );
+            }
+        }
+    }
+
+    SUBCASE("Red-black tree random operations") {
+
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<ucosm::ITask<int8_t>, ucosm::RBTree> sched(getQueueClock);
+
+        constexpr int task_count = 200;
+        RecordTask tasks[task_count];
+
+        std::srand(42);
+
+        for (int i = 0; i < 5000; i++) {
+
+            auto& t = tasks[std::rand() % task_count];
+
+            switch (std::rand() % 3) {
+                case 0:
+                    sched.addTask(t);
+                    break;
+                case 1:
+                    t.removeTask();
+                    break;
+                default:
+                    if (t.isLinked()) {
+                        sched.setDelay(t, std::rand() % 1000);
+                    }
+                    break;
+            }
+        }
+
+        std::size_t count = 0;
+        for (auto& t : tasks) {
+            count += t.isLinked();
+        }
+        CHECK(sched.size() == count);
+
+        // tasks come out in rank order
+        std::vector<uint32_t> ranks;
+        for (auto& t : tasks) {
+            t.setPeriod(0xFFFFFF);
+        }
+
+        sQueueClock = 2000;
+
+        while (ranks.size() < count) {
+            ranks.push_back(sched.getNextRank());
+            sched.run();
+        }
+
+        CHECK(std::is_sorted(ranks.begin(), ranks.end()));
+        CHECK(sched.size() == count);
+    }
+
+    SUBCASE("Pairing heap CFS") {
+
+        struct Task : ucosm::ICFSTask {
+            Task(uint32_t inWork) : mWork(inWork) {}
+            void run() override {
+                sQueueClock += mWork;
+                mRunCounter++;
+            }
+            uint32_t mWork;
+            uint32_t mRunCounter = 0;
+        };
+
+        sQueueClock = 0;
+
+        ucosm::CFSScheduler<ucosm::ITask<int8_t>, ucosm::PairingHeap> sched(getQueueClock);
+
+        Task t1(10);
+        Task t2(10);
+        Task t3(40);
+
+        t1.setPriority(0);
+        t2.setPriority(0);
+        t3.setPriority(0);
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+        sched.addTask(t3);
+
+        for (int i = 0; i < 600; i++) {
+            sched.run();
+        }
+
+        // equal CPU time share
+        CHECK(t1.mRunCounter == doctest::Approx(t2.mRunCounter).epsilon(0.05));
+        CHECK(t1.mRunCounter == doctest::Approx(4 * t3.mRunCounter).epsilon(0.05));
+    }
+
+    SUBCASE("Bulk registration") {
+
+        const std::vector<int> fifo { 0, 1, 3, 5 };
+
+        // ranks are equal, the batch order is kept
+        CHECK(recordBatch<ucosm::SortedList>() == fifo);
+        CHECK(recordBatch<ucosm::TimingWheel>() == fifo);
+        CHECK(recordBatch<ucosm::RBTree>() == fifo);
+
+        auto heap = recordBatch<ucosm::PairingHeap>();
+        std::sort(heap.begin(), heap.end());
+        CHECK(heap == fifo);
+
+        // range of task pointers
+        sQueueClock = 0;
+
+        ucosm::PeriodicScheduler<> sched(getQueueClock);
+
+        RecordTask t1(1, 10);
+        RecordTask t2(2, 10);
+
+        RecordTask* ptrs[] = { &t1, &t2, &t1 };
+
+        CHECK(sched.addTasks(std::begin(ptrs), std::end(ptrs)) == 2);
+        CHECK(sched.size() == 2);
+
+        sched.run();
+        sched.run();
+
+        CHECK(t1.mRunCounter == 1);
+        CHECK(t2.mRunCounter == 1);
+    }
+
+}
@@ -3,97 +3,13 @@
 
 #include "ucosm/rt/rt_scheduler.hpp"
 #include "ucosm/rt/rt_inter_task.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+#include "ucosm/sim/sim_rt_timer.hpp"
 
-#include <iostream>
-#include <thread>
-#include <atomic>
-#include <chrono>
-#include <iomanip>
-#include <cmath>
-
-#ifdef _WIN32
-#include <windows.h>
-#include <mmsystem.h>
-#pragma comment(lib, "winmm.lib")
-#endif
-
-class Timer : public ucosm::RTScheduler::ITimer {
-private:
-    std::atomic<bool> mRunning { false };
-    std::atomic<bool> mShutdown { false };
-    std::atomic<bool> mEnabled { true };
-    std::chrono::high_resolution_clock::time_point mNextWakeup;
-    uint32_t mCounter;
-    std::thread mTimerThread;
-
-
-    void timerISR() {
-#ifdef _WIN32
-        // Set high priority for this thread on Windows
-        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
-#endif
-
-        while (!mShutdown.load(std::memory_order_acquire)) {
-            if (mRunning.load(std::memory_order_acquire) && mEnabled.load(std::memory_order_acquire)) {
-                std::this_thread::sleep_until(mNextWakeup);
-                mCounter = getMillis();
-                run();
-            }
-            else {
-                // Use shorter sleep when not running to be more responsive
-                std::this_thread::sleep_for(std::chrono::microseconds(100));
-            }
-        }
-    }
-
-public:
-    Timer() {
-        mTimerThread = std::thread(&Timer::timerISR, this);
-    }
-
-    ~Timer() {
-        shutdown();
-    }
-
-    void start() override {
-        mNextWakeup = std::chrono::high_resolution_clock::now();
-        mRunning.store(true, std::memory_order_release);
-    }
-
-    void stop() override {
-        mRunning.store(false, std::memory_order_release);
-    }
-
-    bool isRunning() const override {
-        return mRunning.load(std::memory_order_acquire);
-    }
-
-    void setDuration(uint32_t inDuration) override {
-        mNextWakeup += std::chrono::milliseconds(inDuration);
-    }
-
-    void disable() override {
-        mEnabled.store(false, std::memory_order_release);
-    }
-
-    void enable() override {
-        mEnabled.store(true, std::memory_order_release);
-    }
-
-    void shutdown() {
-        // Signal shutdown first with proper memory ordering
-        mShutdown.store(true, std::memory_order_release);
-        mRunning.store(false, std::memory_order_release);
-
-        // Wait for thread to finish with timeout to prevent hanging
-        if (mTimerThread.joinable()) {
-            mTimerThread.join();
-        }
-    }
-};
-
-TEST_CASE("RT task test") {
+namespace {
 
+    // each scheduler has its own timer and its own virtual time
+    template<typename clock_t>
     struct RTTask : ucosm::IPeriodicTask {
 
         RTTask(int id, uint32_t inPeriod) :
@@ -101,69 +17,68 @@ TEST_CASE("RT task test") {
 
         void run() override {
 
-            auto currentTime = getMillis();
+            auto currentTime = clock_t::now();
 
-            if (mFirstExecution) {
-                mFirstExecution = false;
-            }
-            else {
+            // the first run can be delayed by a task due at the same tick
+            if (mCounter > 1) {
                 double period = currentTime - mLastExecution;
                 double error = 100 - ((double) this->getPeriod() / period) * 100;
                 mAverageError += error;
-
-                std::cout
-                    << "Task " << mID << " "
-                    << "| period =" << getPeriod() << "ms "
-                    << "| actual =" << period << "ms "
-                    << "| error =" << std::fixed << std::setprecision(1) << error << "%" << std::endl;
-
             }
 
             mLastExecution = currentTime;
 
             // Simulate work
-            waitFor_ms(std::rand() % 20);
+            clock_t::advance(5 * mID);
 
             if (mCounter++ == 5) {
-                std::cout << "Task " << mID << " completed" << std::endl;
                 this->removeTask();
             }
         }
 
         int error() const {
-            if (mCounter < 2) {
+            if (mCounter < 3) {
                 return 0;
             }
-            return mAverageError / (mCounter - 1);
+            return mAverageError / (mCounter - 2);
         }
 
+        int runs() const { return mCounter; }
+
     private:
 
         double mAverageError = 0;
-        bool mFirstExecution = true;
-        uint32_t mLastExecution;
+        uint32_t mLastExecution = 0;
         int mCounter = 0;
         int mID;
     };
 
-    std::cout << "\n=== RT Scheduler start ===\n" << std::endl;
+}
+
+TEST_CASE("RT task test") {
+
+    using clock1_t = ucosm::SimClock<struct RTTestTag>;
+    using clock2_t = ucosm::SimClock<struct RTTestTag2>;
+
+    clock1_t::set(0);
+    clock2_t::set(0);
 
     //////////////////////////////
 
-    Timer tim;
+    ucosm::SimRTTimer<clock1_t> tim;
     ucosm::RTScheduler sched;
     sched.setTimer(tim);
-    RTTask task1(1, 100);
-    RTTask task2(2, 225);
+    RTTask<clock1_t> task1(1, 100);
+    RTTask<clock1_t> task2(2, 225);
     sched.addTask(task1);
     sched.addTask(task2);
 
     //////////////////////////////
 
-    Timer tim2;
+    ucosm::SimRTTimer<clock2_t> tim2;
     ucosm::RTScheduler sched2;
     sched2.setTimer(tim2);
-    RTTask task3(3, 50);
+    RTTask<clock2_t> task3(3, 50);
     sched2.addTask(task3);
 
     //////////////////////////////
@@ -171,30 +86,23 @@ TEST_CASE("RT task test") {
     CHECK(tim.isRunning());
     CHECK(tim2.isRunning());
 
-    {
-        const auto startTimeout = getMillis();
-        while ((tim.isRunning() || tim2.isRunning()) && (getMillis() - startTimeout) < 30'000);
-    }
+    while (tim.step()) {}
+    while (tim2.step()) {}
 
     CHECK(!tim.isRunning());
     CHECK(!tim2.isRunning());
 
-    int t1AbsError = std::abs(task1.error());
-    int t2AbsError = std::abs(task2.error());
-    int t3AbsError = std::abs(task3.error());
-
-    CHECK(t1AbsError <= 2);
-    CHECK(t2AbsError <= 2);
-    CHECK(t3AbsError <= 2);
-
-    std::cout << "Task 1 average error: " << (int) task1.error() << "%" << std::endl;
-    std::cout << "Task 2 average error: " << (int) task2.error() << "%" << std::endl;
-    std::cout << "Task 3 average error: " << (int) task3.error() << "%" << std::endl;
+    CHECK(task1.runs() == 6);
+    CHECK(task2.runs() == 6);
+    CHECK(task3.runs() == 6);
 
-    tim.shutdown();
-    tim2.shutdown();
+    // the timers don't drift with the work duration
+    CHECK(task1.error() == 0);
+    CHECK(task2.error() == 0);
+    CHECK(task3.error() == 0);
 
-    std::cout << "\n=== RT Scheduler end ===\n" << std::endl;
+    CHECK(clock1_t::now() == 5 * 225 + 2 * 5);
+    CHECK(clock2_t::now() == 5 * 50 + 3 * 5);
 }
 
 TEST_CASE("RT Message Queue") {
@@ -0,0 +1,272 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/sim/sim_clock.hpp"
+#include "ucosm/sim/sim_rt_timer.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/rt/rt_scheduler.hpp"
+
+#include <vector>
+#include <utility>
+
+namespace {
+
+    struct SimTestTag;
+
+    using sim_clock_t = ucosm::SimClock<SimTestTag>;
+
+    struct SimTask : ucosm::IPeriodicTask {
+
+        SimTask(uint32_t inPeriod, uint32_t inWork = 0, uint32_t inMaxRun = 0) :
+            IPeriodicTask(inPeriod),
+            mWork(inWork),
+            mMaxRun(inMaxRun) {}
+
+        void run() override {
+
+            const auto now = sim_clock_t::now();
+
+            // the first run can be delayed by a task due at the same tick
+            if (mRunCounter > 1) {
+                mPeriodError += (now - mLastRun) != getPeriod();
+            }
+
+            mLastRun = now;
+
+            // simulated work
+            sim_clock_t::advance(mWork);
+
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        uint32_t mWork;
+        uint32_t mMaxRun;
+        uint32_t mRunCounter = 0;
+        uint32_t mLastRun = 0;
+        uint32_t mPeriodError = 0;
+    };
+
+}
+
+TEST_CASE("Simulated clock test") {
+
+    SUBCASE("Clocks are independent") {
+        sim_clock_t::set(10);
+        ucosm::SimClock<>::set(0);
+        sim_clock_t::advance(5);
+        CHECK(sim_clock_t::now() == 15);
+        CHECK(ucosm::SimClock<>::now() == 0);
+    }
+
+    SUBCASE("Periodic scheduler fast forward") {
+
+        sim_clock_t::set(0);
+
+        ucosm::PeriodicScheduler<> sched(sim_clock_t::now);
+
+        SimTask t1(100);
+        SimTask t2(225);
+        SimTask t3(50);
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+        sched.addTask(t3);
+
+        // ten hours of 1 ms ticks
+        constexpr uint32_t end = 10 * 3600 * 1000;
+
+        while (sim_clock_t::now() < end) {
+            sched.runReady();
+            sim_clock_t::advance(sched.ticksUntilNext());
+        }
+
+        CHECK(t1.mRunCounter == end / 100);
+        CHECK(t2.mRunCounter == end / 225);
+        CHECK(t3.mRunCounter == end / 50);
+
+        CHECK(t1.mPeriodError == 0);
+        CHECK(t2.mPeriodError == 0);
+        CHECK(t3.mPeriodError == 0);
+    }
+
+    SUBCASE("RT scheduler") {
+
+        // starts close to the tick overflow
+        sim_clock_t::set(0xFFFFFFFF - 1000);
+
+        ucosm::SimRTTimer<sim_clock_t> timer;
+        ucosm::RTScheduler sched;
+
+        REQUIRE(sched.setTimer(timer));
+
+        SimTask t1(100, 7, 6);
+        SimTask t2(225, 19, 6);
+
+        REQUIRE(sched.addTask(t1));
+        REQUIRE(sched.addTask(t2));
+
+        CHECK(timer.isRunning());
+
+        const auto start = sim_clock_t::now();
+
+        while (timer.step()) {}
+
+        CHECK_FALSE(timer.isRunning());
+
+        CHECK(t1.mRunCounter == 6);
+        CHECK(t2.mRunCounter == 6);
+
+        // the periods don't drift with the work duration
+        CHECK(t1.mPeriodError == 0);
+        CHECK(t2.mPeriodError == 0);
+
+        CHECK(t2.mLastRun - start == 5 * 225);
+    }
+
+    SUBCASE("RT timer run until") {
+
+        sim_clock_t::set(0);
+
+        ucosm::SimRTTimer<sim_clock_t> timer;
+        ucosm::RTScheduler sched;
+
+        REQUIRE(sched.setTimer(timer));
+
+        SimTask t1(10);
+        REQUIRE(sched.addTask(t1));
+
+        timer.runUntil(95);
+        CHECK(sim_clock_t::now() == 95);
+        CHECK(t1.mRunCounter == 10);
+
+        // no expiry while disabled
+        timer.disable();
+        CHECK(timer.runFor(50) == 0);
+        CHECK(sim_clock_t::now() == 145);
+
+        // the late deadlines fire at once
+        timer.enable();
+        timer.runFor(0);
+        CHECK(t1.mRunCounter == 15);
+
+        t1.removeTask();
+    }
+
+}
+
+TEST_CASE("Simulated RT deadline misses") {
+
+    using DeadlineMiss = ucosm::IPeriodicTask::DeadlineMiss;
+
+    struct MissTask : SimTask {
+
+        using SimTask::SimTask;
+
+        void onDeadlineMiss(DeadlineMiss inMiss, tick_t inTicks) override {
+            mMisses[static_cast<int>(inMiss)] += inTicks;
+        }
+
+        uint32_t mMisses[2] = {};
+    };
+
+    sim_clock_t::set(0);
+
+    ucosm::SimRTTimer<sim_clock_t> timer;
+    ucosm::RTScheduler sched(&sim_clock_t::now);
+
+    REQUIRE(sched.setTimer(timer));
+
+    // t2 is released at 5 but waits until t1 completes at 14
+    MissTask t1(20, 14, 3);
+    MissTask t2(20, 1, 3);
+    t2.setDeadline(4);
+    t1.setDeadline(30);
+
+    REQUIRE(sched.addTask(t1));
+    REQUIRE(sched.addTask(t2, 5));
+
+    while (timer.step()) {}
+
+    CHECK(t1.mRunCounter == 3);
+    CHECK(t2.mRunCounter == 3);
+
+    CHECK(t1.getLateStarts() == 0);
+    CHECK(t1.getOverruns() == 0);
+
+    CHECK(t2.getLateStarts() == 3);
+    CHECK(t2.getOverruns() == 0);
+    CHECK(t2.mMisses[static_cast<int>(DeadlineMiss::LateStart)] == 3 * 9);
+
+    CHECK(sched.deadlineMisses() == 3);
+
+    SUBCASE("Overrun") {
+
+        MissTask t3(10, 15, 2);
+        t3.setDeadline(100);
+
+        REQUIRE(sched.addTask(t3));
+
+        while (timer.step()) {}
+
+        CHECK(t3.mRunCounter == 2);
+        CHECK(t3.getOverruns() == 2);
+        CHECK(t3.mMisses[static_cast<int>(DeadlineMiss::Overrun)] == 30);
+        CHECK(sched.deadlineMisses() == 5);
+    }
+}
+
+
+TEST_CASE("Simulated RT phase modes") {
+
+    using PhaseMode = ucosm::IPeriodicTask::PhaseMode;
+
+    struct PhaseTask : ucosm::IPeriodicTask {
+
+        using IPeriodicTask::IPeriodicTask;
+
+        void run() override {
+            mRuns.push_back(sim_clock_t::now());
+        }
+
+        std::vector<uint32_t> mRuns;
+    };
+
+    // t2 is added at 5 behind the expiry at 10, it is late by 10 ticks
+    const std::pair<PhaseMode, std::vector<uint32_t>> expected[] = {
+        { PhaseMode::Free, { 10, 14, 18 } },
+        { PhaseMode::CatchUp, { 10, 10, 10, 12, 16, 20 } },
+        { PhaseMode::Skip, { 10, 12, 16, 20 } },
+        { PhaseMode::Compress, { 10, 10, 12, 16, 20 } }
+    };
+
+    for (const auto& [mode, runs] : expected) {
+
+        CAPTURE(static_cast<int>(mode));
+
+        sim_clock_t::set(0);
+
+        ucosm::SimRTTimer<sim_clock_t> timer;
+        ucosm::RTScheduler sched;
+
+        REQUIRE(sched.setTimer(timer));
+
+        PhaseTask t1(10);
+        PhaseTask t2(4);
+        t2.setPhaseMode(mode);
+
+        REQUIRE(sched.addTask(t1));
+        timer.runUntil(5);
+        REQUIRE(sched.addTask(t2));
+        timer.runUntil(20);
+
+        CHECK(t2.mRuns == runs);
+
+        // the other task keeps its phase
+        CHECK(t1.mRuns == std::vector<uint32_t> { 0, 10, 20 });
+
+        t1.removeTask();
+        t2.removeTask();
+    }
+}
@@ -0,0 +1,361 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/static/static_periodic_scheduler.hpp"
+#include "ucosm/static/static_scheduler.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+
+#include <type_traits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace {
+
+    uint32_t sStaticClock = 0;
+
+    uint32_t getStaticClock() {
+        return sStaticClock;
+    }
+
+    using record_t = std::vector<std::pair<uint32_t, int>>;
+
+    struct StaticRecordTask final : ucosm::StaticPeriodicTask<StaticRecordTask> {
+
+        bool init() {
+            mInitCounter++;
+            return true;
+        }
+
+        void deinit() {
+            mDeinitCounter++;
+        }
+
+        void run() {
+            mRecord->emplace_back(sStaticClock, mID);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        record_t* mRecord = nullptr;
+        int mID = 0;
+        uint32_t mMaxRun = 0;
+        uint32_t mRunCounter = 0;
+        uint32_t mInitCounter = 0;
+        uint32_t mDeinitCounter = 0;
+    };
+
+    struct DynamicRecordTask : ucosm::IPeriodicTask {
+
+        void run() override {
+            mRecord->emplace_back(sStaticClock, mID);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        record_t* mRecord = nullptr;
+        int mID = 0;
+        uint32_t mMaxRun = 0;
+        uint32_t mRunCounter = 0;
+    };
+
+    template<typename sched_t, typename task_t>
+    record_t record(uint32_t inStart) {
+
+        constexpr int task_count = 16;
+
+        record_t rec;
+
+        sStaticClock = inStart;
+
+        sched_t sched(getStaticClock);
+
+        task_t tasks[task_count];
+
+        for (int i = 0; i < task_count; i++) {
+            tasks[i].mID = i;
+            tasks[i].mRecord = &rec;
+            tasks[i].mMaxRun = 5 + i % 4;
+            tasks[i].setPeriod(1 + (i * 7) % 11);
+            sched.addTask(tasks[i]);
+        }
+
+        for (uint32_t t = 0; t < 100; t++) {
+            sStaticClock = inStart + t;
+            for (int i = 0; i < task_count + 1; i++) {
+                sched.run();
+            }
+        }
+
+        CHECK(sched.empty());
+
+        return rec;
+    }
+
+}
+
+TEST_CASE("Static task test") {
+
+    SUBCASE("No virtual dispatch") {
+        static_assert(!std::is_polymorphic_v<StaticRecordTask>);
+        static_assert(sizeof(StaticRecordTask) < sizeof(DynamicRecordTask));
+    }
+
+    SUBCASE("Same execution as the periodic scheduler") {
+
+        using static_sched_t = ucosm::StaticPeriodicScheduler<StaticRecordTask>;
+        using dynamic_sched_t = ucosm::PeriodicScheduler<>;
+
+        for (uint32_t start : { 0u, 0xFFFFFFFFu - 50 }) {
+
+            auto staticRecord = record<static_sched_t, StaticRecordTask>(start);
+            auto dynamicRecord = record<dynamic_sched_t, DynamicRecordTask>(start);
+
+            CHECK(staticRecord.size() == dynamicRecord.size());
+
+            std::sort(staticRecord.begin(), staticRecord.end());
+            std::sort(dynamicRecord.begin(), dynamicRecord.end());
+
+            CHECK(staticRecord == dynamicRecord);
+        }
+    }
+
+    SUBCASE("Init, deinit and nesting") {
+
+        sStaticClock = 0;
+
+        record_t rec;
+
+        ucosm::PeriodicScheduler<> parent(getStaticClock);
+        ucosm::StaticPeriodicScheduler<StaticRecordTask, ucosm::IPeriodicTask> sched(getStaticClock);
+
+        StaticRecordTask t1;
+        StaticRecordTask t2;
+
+        t1.mRecord = &rec;
+        t2.mRecord = &rec;
+        t1.mID = 1;
+        t2.mID = 2;
+        t1.setPeriod(10);
+        t2.setPeriod(10);
+
+        CHECK(sched.addTask(t1));
+        CHECK(sched.addTask(t2));
+        CHECK_FALSE(sched.addTask(t1));
+        CHECK(t1.mInitCounter == 1);
+
+        sched.setDelay(t1, 5);
+
+        sched.setPeriod(1);
+        parent.addTask(sched);
+
+        parent.run();
+        CHECK(rec.size() == 1);
+        CHECK(rec.back().second == 2);
+
+        sStaticClock = 5;
+        parent.run();
+        CHECK(rec.size() == 2);
+        CHECK(rec.back().second == 1);
+
+        t2.removeTask();
+        CHECK(t2.mDeinitCounter == 1);
+        CHECK(sched.size() == 1);
+
+        t2.removeTask();
+        CHECK(t2.mDeinitCounter == 1);
+    }
+
+}
+
+namespace {
+
+    struct SlowTask : ucosm::IPeriodicTask {
+        SlowTask() : ucosm::IPeriodicTask(7) {}
+        void run() override {
+            mRecord->emplace_back(sStaticClock, 0);
+        }
+        record_t* mRecord = nullptr;
+    };
+
+    struct FastTask : ucosm::IPeriodicTask {
+        FastTask() : ucosm::IPeriodicTask(3) {}
+        void run() override {
+            mRecord->emplace_back(sStaticClock, 1);
+            if (++mRunCounter == 10) {
+                removeTask();
+            }
+        }
+        void deinit() override {
+            mDeinitCounter++;
+        }
+        record_t* mRecord = nullptr;
+        uint32_t mRunCounter = 0;
+        uint32_t mDeinitCounter = 0;
+    };
+
+    struct WorkTask : ucosm::ICFSTask {
+        WorkTask(uint32_t inWork) : mWork(inWork) {}
+        void run() override {
+            sStaticClock += mWork;
+            mRunCounter++;
+        }
+        uint32_t mWork;
+        uint32_t mRunCounter = 0;
+    };
+
+    struct ShortTask : WorkTask { ShortTask() : WorkTask(10) {} };
+    struct LongTask : WorkTask { LongTask() : WorkTask(40) {} };
+
+}
+
+TEST_CASE("Static scheduler test") {
+
+    SUBCASE("Periodic task set") {
+
+        for (uint32_t start : { 0u, 0xFFFFFFFFu - 20 }) {
+
+            record_t staticRecord;
+            record_t dynamicRecord;
+
+            sStaticClock = start;
+
+            ucosm::StaticScheduler<SlowTask, FastTask> sched(getStaticClock);
+            ucosm::PeriodicScheduler<> dynamicSched(getStaticClock);
+
+            SlowTask slow;
+            FastTask fast;
+
+            slow.mRecord = &dynamicRecord;
+            fast.mRecord = &dynamicRecord;
+            sched.get<0>().mRecord = &staticRecord;
+            sched.get<1>().mRecord = &staticRecord;
+
+            CHECK(sched.empty());
+            CHECK(sched.addTasks() == 2);
+            CHECK(sched.addTask<0>() == false);
+            CHECK(sched.size() == 2);
+
+            dynamicSched.addTask(slow);
+            dynamicSched.addTask(fast);
+
+            for (uint32_t t = 0; t < 60; t++) {
+                sStaticClock = start + t;
+                for (int i = 0; i < 3; i++) {
+                    sched.run();
+                    dynamicSched.run();
+                }
+            }
+
+            std::sort(staticRecord.begin(), staticRecord.end());
+            std::sort(dynamicRecord.begin(), dynamicRecord.end());
+
+            CHECK(staticRecord == dynamicRecord);
+
+            // the fast task removed itself
+            CHECK(sched.size() == 1);
+            CHECK(sched.get<1>().mRunCounter == 10);
+            CHECK(sched.get<1>().mDeinitCounter == 1);
+
+            // and can be added again
+            CHECK(sched.addTask<1>());
+            sched.setDelay<1>(5);
+            CHECK(sched.size() == 2);
+        }
+    }
+
+    SUBCASE("CFS task set") {
+
+        sStaticClock = 0;
+
+        ucosm::StaticScheduler<ShortTask, ShortTask, LongTask> sched(getStaticClock);
+
+        sched.addTasks();
+
+        for (int i = 0; i < 600; i++) {
+            sched.run();
+        }
+
+        auto& t1 = sched.get<0>();
+        auto& t2 = sched.get<1>();
+        auto& t3 = sched.get<2>();
+
+        // equal CPU time share
+        CHECK(t1.mRunCounter == doctest::Approx(t2.mRunCounter).epsilon(0.05));
+        CHECK(t1.mRunCounter == doctest::Approx(4 * t3.mRunCounter).epsilon(0.05));
+    }
+
+    SUBCASE("Phase modes") {
+
+        using PhaseMode = ucosm::IPeriodicTask::PhaseMode;
+
+        // period 7, late by 6 at 13, then overrun until 45
+        const std::pair<PhaseMode, std::size_t> expected[] = {
+            { PhaseMode::Free, 5 },
+            { PhaseMode::CatchUp, 9 },
+            { PhaseMode::Skip, 7 },
+            { PhaseMode::Compress, 8 }
+        };
+
+        for (const auto& [mode, runs] : expected) {
+
+            CAPTURE(static_cast<int>(mode));
+
+            record_t staticRecord;
+            record_t dynamicRecord;
+
+            sStaticClock = 0;
+
+            ucosm::StaticScheduler<SlowTask> sched(getStaticClock);
+            ucosm::PeriodicScheduler<> dynamicSched(getStaticClock);
+
+            SlowTask slow;
+
+            slow.mRecord = &dynamicRecord;
+            slow.setPhaseMode(mode);
+            sched.get<0>().mRecord = &staticRecord;
+            sched.get<0>().setPhaseMode(mode);
+
+            sched.addTasks();
+            dynamicSched.addTask(slow);
+
+            // a late run, then an overrun
+            for (uint32_t t : { 0u, 13u, 20u, 23u, 45u, 50u, 55u, 60u }) {
+                sStaticClock = t;
+                for (int i = 0; i < 4; i++) {
+                    sched.run();
+                    dynamicSched.run();
+                }
+            }
+
+            CHECK(staticRecord.size() == runs);
+            CHECK(staticRecord == dynamicRecord);
+        }
+    }
+
+    SUBCASE("Nested static scheduler") {
+
+        record_t rec;
+
+        sStaticClock = 0;
+
+        ucosm::PeriodicScheduler<> parent(getStaticClock);
+        ucosm::BasicStaticScheduler<ucosm::IPeriodicTask, SlowTask> sched(getStaticClock);
+
+        sched.get<0>().mRecord = &rec;
+        sched.addTasks();
+        sched.setPeriod(1);
+
+        parent.addTask(sched);
+
+        for (uint32_t t = 0; t < 15; t++) {
+            sStaticClock = t;
+            parent.run();
+        }
+
+        CHECK(rec.size() == 3);
+    }
+
+}
@@ -0,0 +1,277 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/cfs/cfs_scheduler.hpp"
+#include "ucosm/rt/rt_scheduler.hpp"
+#include "ucosm/priority/priority_scheduler.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+
+#include <type_traits>
+
+namespace {
+
+    using stats_clock_t = ucosm::SimClock<struct StatsTestTag>;
+
+    // advances the clock by its cost on each run
+    template<typename task_t>
+    struct CostTask : task_t {
+
+        void run() override {
+            stats_clock_t::advance(mCost);
+            if (++mRunCounter == mMaxRun) {
+                this->removeTask();
+            }
+        }
+
+        uint32_t mCost = 0;
+        uint32_t mRunCounter = 0;
+        uint32_t mMaxRun = 0;
+    };
+
+    // timer fired by the test
+    struct ManualTimer : ucosm::RTScheduler::ITimer {
+        void start() override { mRunning = true; }
+        void stop() override { mRunning = false; }
+        bool isRunning() const override { return mRunning; }
+        void setDuration(uint32_t inDuration) override { mDuration = inDuration; }
+        void disable() override {}
+        void enable() override {}
+
+        bool mRunning = false;
+        uint32_t mDuration = 0;
+    };
+
+    using stats_periodic_t = ucosm::PeriodicScheduler<
+        ucosm::ITask<int8_t>,
+        ucosm::SortedList,
+        ucosm::StatsTable<2>
+    >;
+
+}
+
+TEST_CASE("Task statistics test") {
+
+    stats_clock_t::set(0);
+
+    static_assert(std::is_empty_v<ucosm::NoStats>);
+
+    SUBCASE("Periodic scheduler") {
+
+        stats_periodic_t sched(stats_clock_t::now);
+
+        CostTask<ucosm::IPeriodicTask> t1, t2, t3;
+
+        t1.setPeriod(10);
+        t1.mCost = 2;
+        t2.setPeriod(10);
+        t2.mCost = 3;
+        t3.setPeriod(10);
+        t3.mCost = 1;
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+
+        // t2 runs first, then t1 starts 3 ticks late
+        sched.runReady();
+
+        const auto* s1 = sched.statsOf(t1);
+        const auto* s2 = sched.statsOf(t2);
+
+        REQUIRE(s1);
+        REQUIRE(s2);
+
+        CHECK(s1->runCount == 1);
+        CHECK(s1->lastTicks == 2);
+        CHECK(s1->lastLateness == 3);
+        CHECK(s2->runCount == 1);
+        CHECK(s2->lastTicks == 3);
+        CHECK(s2->lastLateness == 0);
+
+        t1.mCost = 6;
+
+        stats_clock_t::set(10);
+        sched.runReady();
+        stats_clock_t::set(20);
+        sched.runReady();
+
+        CHECK(s1->runCount == 3);
+        CHECK(s1->lastTicks == 6);
+        CHECK(s1->maxTicks == 6);
+        CHECK(s1->totalTicks == 14);
+        CHECK(s2->maxLateness == 6);
+
+        // the table is full
+        CHECK(sched.addTask(t3));
+        sched.run();
+        CHECK(sched.statsOf(t3) == nullptr);
+        CHECK(sched.droppedStats() == 1);
+
+        int count = 0;
+        uint64_t total = 0;
+        sched.forEachStats(
+            [&] (ucosm::IPeriodicTask& t, const ucosm::TaskStats& s) {
+                CHECK(((&t == &t1) || (&t == &t2)));
+                total += s.totalTicks;
+                count++;
+            }
+        );
+
+        CHECK(count == 2);
+        CHECK(total == 14 + 9);
+
+        sched.resetStats();
+        CHECK(sched.statsOf(t1) == nullptr);
+        CHECK(sched.droppedStats() == 0);
+    }
+
+    SUBCASE("Removed tasks are forgotten") {
+
+        stats_periodic_t sched(stats_clock_t::now);
+
+        CostTask<ucosm::IPeriodicTask> t1, t2, t3;
+
+        t1.mCost = 2;
+        t1.mMaxRun = 1;
+        t2.mCost = 1;
+        t2.mMaxRun = 1;
+        t3.setPeriod(10);
+        t3.mCost = 1;
+
+        sched.addTask(t1);
+        sched.addTask(t3);
+        sched.runReady();
+
+        // the record of t1 is dropped with the task
+        CHECK(sched.statsOf(t1) == nullptr);
+        REQUIRE(sched.statsOf(t3));
+
+        // so the table has room for the next one
+        sched.addTask(t2);
+        sched.run();
+        CHECK(sched.droppedStats() == 0);
+        CHECK(sched.statsOf(t2) == nullptr);
+
+        // a task added again starts afresh
+        t1.mRunCounter = 0;
+        t1.mMaxRun = 2;
+        sched.addTask(t1);
+        sched.run();
+        REQUIRE(sched.statsOf(t1));
+        CHECK(sched.statsOf(t1)->runCount == 1);
+
+        t1.removeTask();
+        sched.addTask(t1);
+        CHECK(sched.statsOf(t1) == nullptr);
+
+        sched.clear();
+        CHECK(sched.statsOf(t3) == nullptr);
+        CHECK(sched.droppedStats() == 0);
+    }
+
+    SUBCASE("CFS scheduler") {
+
+        ucosm::CFSScheduler<
+            ucosm::ITask<int8_t>,
+            ucosm::RBTree,
+            ucosm::StatsTable<4>
+        > sched(stats_clock_t::now);
+
+        CostTask<ucosm::ICFSTask> t1, t2;
+
+        t1.mCost = 4;
+        t2.mCost = 1;
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+
+        for (int i = 0; i < 10; i++) {
+            sched.run();
+        }
+
+        const auto* s1 = sched.statsOf(t1);
+        const auto* s2 = sched.statsOf(t2);
+
+        REQUIRE(s1);
+        REQUIRE(s2);
+
+        CHECK(s1->runCount == t1.mRunCounter);
+        CHECK(s1->totalTicks == 4 * t1.mRunCounter);
+        CHECK(s1->maxLateness == 0);
+        CHECK(s2->runCount == t2.mRunCounter);
+        CHECK(s2->maxTicks == 1);
+        CHECK(s1->runCount + s2->runCount == 10);
+
+        // the lighter task runs more often
+        CHECK(s2->runCount > s1->runCount);
+    }
+
+    SUBCASE("Priority scheduler") {
+
+        ucosm::PriorityScheduler<8, ucosm::ITask<int8_t>, ucosm::StatsTable<2>> sched(stats_clock_t::now);
+
+        CostTask<ucosm::IPriorityTask> t1, t2;
+
+        t1.setPriority(0);
+        t2.setPriority(1);
+        t1.mCost = 3;
+        t2.mCost = 2;
+        t1.mMaxRun = 2;
+
+        sched.addTask(t1);
+        sched.addTask(t2);
+
+        sched.run();
+
+        const auto* s1 = sched.statsOf(t1);
+
+        REQUIRE(s1);
+        CHECK(s1->runCount == 1);
+        CHECK(s1->totalTicks == 3);
+        CHECK(s1->maxLateness == 0);
+
+        for (int i = 0; i < 5; i++) {
+            sched.run();
+        }
+
+        // t1 was removed by its second run
+        CHECK(sched.statsOf(t1) == nullptr);
+
+        const auto* s2 = sched.statsOf(t2);
+
+        REQUIRE(s2);
+        CHECK(s2->runCount == 4);
+        CHECK(s2->totalTicks == 8);
+        CHECK(s2->maxTicks == 2);
+    }
+
+    SUBCASE("RT scheduler") {
+
+        // the timer outlives the scheduler, which stops it on destruction
+        ManualTimer timer;
+        ucosm::BasicRTScheduler<ucosm::StatsTable<2>> sched(stats_clock_t::now);
+
+        REQUIRE(sched.setTimer(timer));
+
+        CostTask<ucosm::IPeriodicTask> t1;
+        t1.setPeriod(5);
+        t1.mCost = 2;
+
+        REQUIRE(sched.addTask(t1));
+
+        // the timer fires one tick late
+        while (t1.mRunCounter < 3) {
+            REQUIRE(timer.isRunning());
+            stats_clock_t::advance(timer.mDuration + 1);
+            static_cast<ucosm::ITask<uint8_t>&>(sched).run();
+        }
+
+        const auto* s1 = sched.statsOf(t1);
+
+        REQUIRE(s1);
+        CHECK(s1->runCount == 3);
+        CHECK(s1->totalTicks == 6);
+        CHECK(s1->lastLateness == 1);
+    }
+
+}
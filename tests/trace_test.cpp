@@ -0,0 +1,225 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/rt/rt_scheduler.hpp"
+#include "ucosm/trace/chrome_trace.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include "ucosm/trace/mapped_file_stream.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#endif
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using trace_clock_t = ucosm::SimClock<struct TraceTestTag>;
+
+    struct NamedTask : ucosm::IPeriodicTask {
+
+        NamedTask(std::string_view inName) :
+            mName(inName) {}
+
+        std::string_view name() override { return mName; }
+
+        void run() override {
+            trace_clock_t::advance(2);
+            if (++mRunCounter == mMaxRun) {
+                removeTask();
+            }
+        }
+
+        std::string_view mName;
+        uint32_t mRunCounter = 0;
+        uint32_t mMaxRun = 0;
+    };
+
+    struct TraceTimer : ucosm::RTScheduler::ITimer {
+        void start() override { mRunning = true; }
+        void stop() override { mRunning = false; }
+        bool isRunning() const override { return mRunning; }
+        void setDuration(uint32_t inDuration) override { mDuration = inDuration; }
+        void disable() override {}
+        void enable() override {}
+
+        bool mRunning = false;
+        uint32_t mDuration = 0;
+    };
+
+    using event_list_t = std::vector<std::pair<ucosm::TraceEvent, std::string_view>>;
+
+    event_list_t events(const ucosm::TraceRing& inRing) {
+        event_list_t list;
+        inRing.forEach(
+            [&] (const ucosm::TraceRecord& r) {
+                list.emplace_back(r.event, r.name);
+            }
+        );
+        return list;
+    }
+
+}
+
+TEST_CASE("Trace test") {
+
+    using ucosm::TraceEvent;
+
+    trace_clock_t::set(0);
+
+    SUBCASE("Periodic scheduler events") {
+
+        ucosm::TraceBuffer<64> trace(trace_clock_t::now);
+        ucosm::PeriodicScheduler<> sched(trace_clock_t::now);
+
+        sched.setTrace(&trace);
+
+        NamedTask t1("t1");
+        t1.setPeriod(10);
+        t1.mMaxRun = 1;
+
+        sched.addTask(t1);
+        sched.run();
+
+        // only the idle entry is recorded
+        sched.run();
+        sched.run();
+
+        CHECK(
+            events(trace) == event_list_t {
+                { TraceEvent::TaskAdd, "t1" },
+                { TraceEvent::TaskStart, "t1" },
+                { TraceEvent::TaskStop, "t1" },
+                { TraceEvent::TaskRemove, "t1" },
+                { TraceEvent::Idle, "" }
+            }
+        );
+
+        std::vector<uint32_t> ticks;
+        trace.forEach([&] (const ucosm::TraceRecord& r) { ticks.push_back(r.tick); });
+        CHECK(ticks == std::vector<uint32_t> { 0, 0, 2, 2, 2 });
+
+        sched.setTrace(nullptr);
+        sched.addTask(t1);
+        CHECK(trace.written() == 5);
+    }
+
+    SUBCASE("Ring overwrite") {
+
+        ucosm::TraceBuffer<8> trace(trace_clock_t::now);
+
+        for (uint32_t i = 0; i < 20; i++) {
+            trace_clock_t::set(i);
+            trace.record(TraceEvent::TimerSet, {}, i);
+        }
+
+        std::vector<uint32_t> values;
+        const auto count = trace.forEach([&] (const ucosm::TraceRecord& r) { values.push_back(r.value); });
+
+        CHECK(count == 8);
+        CHECK(trace.written() == 20);
+        CHECK(values == std::vector<uint32_t> { 12, 13, 14, 15, 16, 17, 18, 19 });
+    }
+
+    SUBCASE("RT timer events") {
+
+        ucosm::TraceBuffer<32> trace(trace_clock_t::now);
+        // the timer outlives the scheduler, which stops it on destruction
+        TraceTimer timer;
+        ucosm::RTScheduler sched;
+
+        sched.setTrace(&trace);
+        REQUIRE(sched.setTimer(timer));
+
+        NamedTask t1("rt");
+        t1.setPeriod(5);
+        t1.mMaxRun = 2;
+
+        REQUIRE(sched.addTask(t1, 3));
+
+        while (timer.isRunning()) {
+            static_cast<ucosm::ITask<uint8_t>&>(sched).run();
+        }
+
+        std::vector<uint32_t> durations;
+        trace.forEach(
+            [&] (const ucosm::TraceRecord& r) {
+                if (r.event == TraceEvent::TimerSet) {
+                    durations.push_back(r.value);
+                }
+            }
+        );
+
+        // start delay, re-armed once by the first expiry, then the period
+        CHECK(durations == std::vector<uint32_t> { 3, 3, 5 });
+
+        const auto list = events(trace);
+        REQUIRE(list.size() >= 2);
+        CHECK(list[list.size() - 2] == std::make_pair(TraceEvent::TaskRemove, std::string_view("rt")));
+        CHECK(list.back().first == TraceEvent::TimerStop);
+    }
+
+    SUBCASE("Chrome trace export") {
+
+        ucosm::TraceBuffer<16> trace(trace_clock_t::now);
+
+        trace_clock_t::set(0xFFFFFFFF);
+        trace.record(TraceEvent::TaskStart, "a\"b");
+        trace_clock_t::set(1);
+        trace.record(TraceEvent::TaskStop, "a\"b");
+        trace.record(TraceEvent::Idle);
+        trace.record(TraceEvent::TimerSet, {}, 7);
+
+        std::ostringstream out;
+        CHECK(ucosm::writeChromeTrace(trace, out, 1000, 3) == 4);
+
+        const auto json = out.str();
+
+        CHECK(
+            json ==
+            "{\"traceEvents\":["
+            "\n{\"name\":\"a\\\"b\",\"cat\":\"task\",\"ph\":\"B\",\"ts\":0,\"pid\":0,\"tid\":3},"
+            "\n{\"name\":\"a\\\"b\",\"cat\":\"task\",\"ph\":\"E\",\"ts\":2000,\"pid\":0,\"tid\":3},"
+            "\n{\"name\":\"idle\",\"cat\":\"scheduler\",\"ph\":\"i\",\"ts\":2000,\"pid\":0,\"tid\":3,\"s\":\"t\"},"
+            "\n{\"name\":\"timer\",\"cat\":\"scheduler\",\"ph\":\"C\",\"ts\":2000,\"pid\":0,\"tid\":3,\"args\":{\"duration\":7}}"
+            "\n]}\n"
+        );
+
+#if defined(__unix__) || defined(__APPLE__)
+
+        const std::string path = "ucosm_trace_test.json";
+
+        {
+            ucosm::MappedFileStream file(path.c_str(), 4096);
+            REQUIRE(file.isOpen());
+            ucosm::writeChromeTrace(trace, file, 1000, 3);
+            CHECK_FALSE(file.overflow());
+            CHECK(file.size() == json.size());
+        }
+
+        std::ifstream in(path);
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CHECK(content == json);
+
+        {
+            // the first event doesn't fit, the smaller chunks after it would
+            ucosm::MappedFileStream file(path.c_str(), 40);
+            CHECK(ucosm::writeChromeTrace(trace, file, 1000, 3) == 0);
+            CHECK(file.overflow());
+        }
+
+        // a clean prefix of the trace
+        std::ifstream truncated(path);
+        const std::string prefix((std::istreambuf_iterator<char>(truncated)), std::istreambuf_iterator<char>());
+        CHECK(prefix == json.substr(0, prefix.size()));
+
+        std::remove(path.c_str());
+#endif
+    }
+
+}
@@ -0,0 +1,335 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/resumable/iresumable_task.hpp"
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/rt/rt_inter_task.hpp"
+#include "ucosm/core/task_waiter.hpp"
+#include "ucosm/wakeup/thread_wakeup.hpp"
+#include "ucosm/sim/sim_clock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using wait_clock_t = ucosm::SimClock<struct WaitTestTag>;
+
+    using queue_t = ucosm::RTMessageQueue<int, 64>;
+
+    // sums the received messages, parked while the queue is empty
+    struct Consumer : ucosm::IResumableTask {
+
+        template<typename scheduler_t>
+        Consumer(scheduler_t& inScheduler, queue_t& inQueue) :
+            mQueue(inQueue),
+            mWaiter(inScheduler, *this) {
+            mQueue.setWakeup(&mWaiter);
+        }
+
+        void run() override {
+
+            mRunCounter++;
+
+            UCOSM_START;
+
+            UCOSM_WAIT_UNTIL(!mQueue.empty(), mWaiter);
+
+            int message;
+            while (mQueue.tryReceive(message)) {
+                if (message < 0) {
+                    mDone = true;
+                    this->removeTask();
+                    return;
+                }
+                mSum += message;
+                mReceived++;
+            }
+
+            // wait for the next messages
+            UCOSM_RESTART;
+
+            UCOSM_END;
+        }
+
+        queue_t& mQueue;
+        ucosm::TaskWaiter<ucosm::PeriodicScheduler<>, ucosm::IPeriodicTask> mWaiter;
+        std::atomic<uint32_t> mRunCounter { 0 };
+        uint32_t mReceived = 0;
+        int mSum = 0;
+        bool mDone = false;
+    };
+
+    struct FlagTask : ucosm::IResumableTask {
+
+        static constexpr ucosm::RTEventFlags::flags_t kStart = 1;
+        static constexpr ucosm::RTEventFlags::flags_t kStop = 2;
+
+        FlagTask(ucosm::PeriodicScheduler<>& inScheduler, ucosm::RTEventFlags& inFlags) :
+            mFlags(inFlags),
+            mWaiter(inScheduler, *this) {
+            mFlags.setWakeup(&mWaiter, kStart | kStop);
+        }
+
+        void run() override {
+
+            mRunCounter++;
+
+            UCOSM_START;
+
+            UCOSM_WAIT_UNTIL(mFlags.testAny(kStart), mWaiter);
+            mFlags.clearFlags(kStart);
+            mStarted = true;
+
+            UCOSM_WAIT_UNTIL(mFlags.testAny(kStop), mWaiter);
+            mStopped = true;
+
+            UCOSM_END;
+        }
+
+        ucosm::RTEventFlags& mFlags;
+        ucosm::TaskWaiter<ucosm::PeriodicScheduler<>, ucosm::IPeriodicTask> mWaiter;
+        uint32_t mRunCounter = 0;
+        bool mStarted = false;
+        bool mStopped = false;
+    };
+
+    // parks on each run
+    struct ParkTask : ucosm::IPeriodicTask {
+
+        ParkTask(ucosm::PeriodicScheduler<>& inScheduler) :
+            mWaiter(inScheduler, *this) {}
+
+        void run() override {
+            mRunCounter++;
+            mWaiter.park();
+        }
+
+        void deinit() override { mDeinitCounter++; }
+
+        std::string_view name() override { return "park"; }
+
+        ucosm::TaskWaiter<ucosm::PeriodicScheduler<>, ucosm::IPeriodicTask> mWaiter;
+        uint32_t mRunCounter = 0;
+        uint32_t mDeinitCounter = 0;
+    };
+
+}
+
+TEST_CASE("wait on a message queue") {
+
+    ucosm::PeriodicScheduler sched(wait_clock_t::now);
+    queue_t queue;
+    Consumer consumer(sched, queue);
+
+    CHECK(sched.addTask(consumer));
+
+    sched.run();
+
+    // parked outside the ready queue, still held by the scheduler
+    CHECK(consumer.mRunCounter == 1);
+    CHECK(consumer.mWaiter.isParked());
+    CHECK_FALSE(sched.empty());
+    CHECK(sched.size() == 1);
+    CHECK(consumer.isLinked());
+    CHECK(sched.ticksUntilNext() == std::numeric_limits<uint32_t>::max());
+
+    for (int i = 0; i < 10; i++) {
+        wait_clock_t::advance(1);
+        sched.run();
+    }
+    CHECK(consumer.mRunCounter == 1);
+
+    // the producer resumes the consumer, once
+    CHECK(queue.trySend(3));
+    CHECK(queue.trySend(4));
+    CHECK_FALSE(consumer.mWaiter.isParked());
+
+    sched.run();
+    CHECK(consumer.mRunCounter == 2);
+    CHECK(consumer.mSum == 7);
+
+    // restarts and parks again
+    sched.run();
+    CHECK(consumer.mRunCounter == 3);
+    CHECK(consumer.mWaiter.isParked());
+    CHECK(sched.size() == 1);
+
+    // the end message removes the task
+    CHECK(queue.trySend(-1));
+    sched.run();
+    CHECK(consumer.mRunCounter == 4);
+    CHECK_FALSE(consumer.isLinked());
+    CHECK_FALSE(consumer.mWaiter.isParked());
+    CHECK(sched.empty());
+
+    // a removed task isn't resumed anymore
+    CHECK(queue.trySend(1));
+    sched.run();
+    CHECK(consumer.mRunCounter == 4);
+}
+
+TEST_CASE("wait on event flags") {
+
+    ucosm::PeriodicScheduler sched(wait_clock_t::now);
+    ucosm::RTEventFlags flags;
+    FlagTask task(sched, flags);
+
+    CHECK(sched.addTask(task));
+    sched.run();
+    CHECK(task.mRunCounter == 1);
+    CHECK_FALSE(sched.empty());
+
+    // flags out of the mask don't wake the task
+    flags.setFlags(4);
+    sched.run();
+    CHECK(task.mRunCounter == 1);
+
+    flags.setFlags(FlagTask::kStart);
+    sched.run();
+    CHECK(task.mStarted);
+    CHECK_FALSE(task.mStopped);
+    CHECK(task.mRunCounter == 2);
+    CHECK(task.mWaiter.isParked());
+
+    flags.setFlags(FlagTask::kStop);
+    sched.run();
+    CHECK(task.mStopped);
+    CHECK(task.mRunCounter == 3);
+    CHECK_FALSE(task.isLinked());
+    CHECK(sched.empty());
+}
+
+TEST_CASE("remove a parked task") {
+
+    ucosm::TraceRecord records[16];
+    ucosm::TraceRing trace(records, 16, wait_clock_t::now);
+
+    ucosm::PeriodicScheduler sched(wait_clock_t::now);
+    sched.setTrace(&trace);
+
+    ParkTask task(sched);
+
+    CHECK(sched.addTask(task));
+    sched.run();
+    CHECK(task.mRunCounter == 1);
+    CHECK(task.mWaiter.isParked());
+
+    // resumed, parked again
+    task.mWaiter.notify();
+    sched.run();
+    CHECK(task.mRunCounter == 2);
+    CHECK(task.mWaiter.isParked());
+
+    std::vector<ucosm::TraceEvent> events;
+    trace.forEach(
+        [&] (const ucosm::TraceRecord& r) {
+            if (r.event != ucosm::TraceEvent::Idle) {
+                events.push_back(r.event);
+            }
+        }
+    );
+
+    using ucosm::TraceEvent;
+
+    // parking isn't recorded as a removal
+    CHECK(
+        events == std::vector<TraceEvent> {
+            TraceEvent::TaskAdd,
+            TraceEvent::TaskStart,
+            TraceEvent::TaskPark,
+            TraceEvent::TaskStop,
+            TraceEvent::TaskResume,
+            TraceEvent::TaskStart,
+            TraceEvent::TaskPark,
+            TraceEvent::TaskStop
+        }
+    );
+
+    SUBCASE("remove") {
+        task.removeTask();
+        CHECK(task.mDeinitCounter == 1);
+        CHECK(sched.empty());
+
+        // a late resume doesn't bring it back
+        task.mWaiter.notify();
+        sched.run();
+        CHECK(task.mRunCounter == 2);
+        CHECK_FALSE(task.isLinked());
+    }
+
+    SUBCASE("clear") {
+        sched.clear();
+        CHECK(sched.empty());
+        CHECK_FALSE(task.isLinked());
+    }
+
+    SUBCASE("delay") {
+        // a parked task stays parked
+        sched.setDelay(task, 5);
+        CHECK(task.mWaiter.isParked());
+        CHECK(sched.ticksUntilNext() == std::numeric_limits<uint32_t>::max());
+
+        sched.run();
+        sched.run();
+        CHECK(task.mRunCounter == 2);
+
+        // and runs once, when resumed
+        task.mWaiter.notify();
+        sched.run();
+        sched.run();
+        CHECK(task.mRunCounter == 3);
+        CHECK(task.mWaiter.isParked());
+    }
+}
+
+TEST_CASE("wait with a producer thread") {
+
+    ucosm::PeriodicScheduler sched(getMillis);
+    ucosm::ThreadWakeup wakeup;
+    sched.setWakeup(&wakeup);
+
+    queue_t queue;
+    Consumer consumer(sched, queue);
+
+    CHECK(sched.addTask(consumer));
+
+    constexpr int messageCount = 200;
+
+    std::thread producer(
+        [&] () {
+            for (int i = 1; i <= messageCount; i++) {
+                while (!queue.trySend(i)) {
+                    std::this_thread::yield();
+                }
+                if ((i % 20) == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            while (!queue.trySend(-1)) {
+                std::this_thread::yield();
+            }
+        }
+    );
+
+    // the loop sleeps while the consumer is parked,
+    // and returns once the consumer removed itself
+    sched.runForever(
+        [&] (uint32_t inTicks) {
+            wakeup.waitFor(std::chrono::milliseconds(std::min<uint32_t>(inTicks, 100)));
+        }
+    );
+
+    CHECK(consumer.mDone);
+
+    producer.join();
+
+    CHECK(consumer.mReceived == messageCount);
+    CHECK(consumer.mSum == messageCount * (messageCount + 1) / 2);
+
+    // at most a wake-up and a restart per message, not a poll per tick
+    CHECK(consumer.mRunCounter <= 2 * messageCount + 2);
+}
@@ -0,0 +1,106 @@
+#include "tests.hpp"
+#include "doctest.h"
+
+#include "ucosm/periodic/periodic_scheduler.hpp"
+#include "ucosm/wakeup/thread_wakeup.hpp"
+
+#if defined(__linux__)
+#include "ucosm/wakeup/eventfd_wakeup.hpp"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+    uint32_t getMillis() {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(
+            duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count()
+        );
+    }
+
+    struct Task : ucosm::IPeriodicTask {
+        Task(uint32_t inPeriod) : ucosm::IPeriodicTask(inPeriod) {}
+        void run() override { mRunCounter++; }
+        uint32_t mRunCounter = 0;
+    };
+
+    template<typename wakeup_t>
+    void checkWakeup() {
+
+        wakeup_t wakeup;
+
+        // nothing to consume
+        CHECK_FALSE(wakeup.waitFor(std::chrono::milliseconds(1)));
+
+        // a notification sent before the wait is kept
+        wakeup.notify();
+        wakeup.notify();
+        CHECK(wakeup.waitFor(std::chrono::hours(1)));
+        CHECK_FALSE(wakeup.waitFor(std::chrono::milliseconds(0)));
+
+        // add and delay notify the wake-up
+        ucosm::PeriodicScheduler sched(getMillis);
+        sched.setWakeup(&wakeup);
+
+        Task t(10);
+
+        sched.addTask(t);
+        CHECK(wakeup.waitFor(std::chrono::milliseconds(0)));
+
+        sched.setDelay(t, 100);
+        CHECK(wakeup.waitFor(std::chrono::milliseconds(0)));
+
+        sched.setWakeup(nullptr);
+        sched.setDelay(t, 100);
+        CHECK_FALSE(wakeup.waitFor(std::chrono::milliseconds(0)));
+
+        // a notification from another thread interrupts a long sleep
+        sched.setWakeup(&wakeup);
+
+        sched.setDelay(t, 100000);
+
+        std::atomic<bool> stop { false };
+
+        std::thread other(
+            [&] () {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                stop = true;
+                sched.notify();
+            }
+        );
+
+        const auto start = std::chrono::steady_clock::now();
+
+        sched.runForever(
+            [&] (uint32_t inTicks) {
+                wakeup.waitFor(std::chrono::milliseconds(inTicks));
+                if (stop) {
+                    sched.clear();
+                }
+            }
+        );
+
+        other.join();
+
+        CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+        CHECK(t.mRunCounter == 0);
+    }
+
+}
+
+TEST_CASE("Wake-up test") {
+
+    SUBCASE("Thread wake-up") {
+        checkWakeup<ucosm::ThreadWakeup>();
+    }
+
+#if defined(__linux__)
+    SUBCASE("eventfd wake-up") {
+        checkWakeup<ucosm::EventFdWakeup>();
+    }
+#endif
+
+}